@@ -133,6 +133,9 @@ macro(write_configtable)
   string(APPEND out "Build with runtime logging    : ")
   check_on_or_off("NS3_LOG" "NS3_LOG")
 
+  string(APPEND out "Build with hot-path traces    : ")
+  check_on_or_off("NS3_HOT_TRACES" "NS3_HOT_TRACES")
+
   string(APPEND out "Build version embedding       : ")
   check_on_or_off("NS3_ENABLE_BUILD_VERSION" "ENABLE_BUILD_VERSION")
 
@@ -166,6 +169,9 @@ macro(write_configtable)
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("NS3_MPI" "MPI_FOUND")
 
+  string(APPEND out "Multithreaded simulation      : ")
+  check_on_or_off("NS3_MTP" "NS3_MTP")
+
   string(APPEND out "ns-3 Click Integration        : ")
   check_on_or_off("ON" "NS3_CLICK")
 
@@ -196,6 +202,9 @@ macro(write_configtable)
   string(APPEND out "Tests                         : ")
   check_on_or_off("ENABLE_TESTS" "ENABLE_TESTS")
 
+  string(APPEND out "Thread-local simulation state : ")
+  check_on_or_off("NS3_THREAD_LOCAL_SIMULATION" "NS3_THREAD_LOCAL_SIMULATION")
+
   # string(APPEND out "Use sudo to set suid bit      : not enabled (option
   # --enable-sudo not selected) string(APPEND out "XmlIo : enabled
   string(APPEND out "\n\n")
@@ -381,6 +381,20 @@ macro(process_options)
     add_definitions(-DENABLE_DES_METRICS)
   endif()
 
+  if(${NS3_THREAD_LOCAL_SIMULATION})
+    add_definitions(-DENABLE_THREAD_LOCAL_SIMULATION)
+  endif()
+
+  if(${NS3_MTP})
+    if(${NS3_THREAD_LOCAL_SIMULATION})
+      message(
+        FATAL_ERROR
+          "Multithreaded simulation can't be used with thread-local simulation state. Disable one of them."
+      )
+    endif()
+    add_definitions(-DNS3_MTP)
+  endif()
+
   if(${NS3_SANITIZE} AND ${NS3_SANITIZE_MEMORY})
     message(
       FATAL_ERROR
@@ -1144,6 +1158,10 @@ macro(process_options)
   if(${NS3_ASSERT} OR (${build_profile} STREQUAL "debug"))
     add_definitions(-DNS3_ASSERT_ENABLE)
   endif()
+  # Hot-path trace sources can only be compiled away in optimized builds
+  if((NOT ${NS3_HOT_TRACES}) AND (NOT (${build_profile} STREQUAL "debug")))
+    add_definitions(-DNS3_HOT_TRACES_DISABLE)
+  endif()
 
   set(ENABLE_TAP OFF)
   if(${NS3_TAP})
@@ -1174,6 +1192,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${NS3_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
@@ -0,0 +1 @@
+#include "/root/repo/src/energy/model/basic-energy-harvester.h"
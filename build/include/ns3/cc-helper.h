@@ -0,0 +1 @@
+#include "/root/repo/src/lte/helper/cc-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/fd-net-device/model/fd-net-device.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/buildings/model/hybrid-buildings-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/lte-radio-bearer-tag.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/mgt-action-headers.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/nist-error-rate-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/pss-ff-mac-scheduler.h"
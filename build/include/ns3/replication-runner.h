@@ -0,0 +1 @@
+#include "/root/repo/src/core/helper/replication-runner.h"
@@ -20,10 +20,15 @@
 
 #include "ns3/abort.h"
 #include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/error-model.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/replication-runner.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device.h"
 #include "ns3/simulator.h"
@@ -346,6 +351,122 @@ UdpEchoClientSetFillTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup applications-test
+ * Count a received packet.
+ * \param [in,out] count The packet counter.
+ * \param [in] packet The packet.
+ */
+static void
+CountEcho(uint32_t* count, Ptr<const Packet> packet)
+{
+    ++*count;
+}
+
+/**
+ * \ingroup applications-test
+ * A UDP echo exchange over a lossy link, run as a replication.
+ *
+ * The MAC addresses and packet uids are allocated by every replication,
+ * so that replications running in parallel exercise the per-thread
+ * allocators.
+ * \param [in] run The run number.
+ * \returns The number of echoes received by the client.
+ */
+static std::vector<double>
+UdpEchoScenario(uint64_t run)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(1)));
+    NetDeviceContainer d;
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetChannel(channel);
+        nodes.Get(i)->AddDevice(dev);
+        d.Add(dev);
+    }
+    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    em->SetAttribute("ErrorRate", DoubleValue(0.2));
+    em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+    d.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(d);
+
+    uint16_t port = 7;
+    UdpEchoServerHelper echoServer(port);
+    echoServer.Install(nodes.Get(1));
+    UdpEchoClientHelper echoClient(interfaces.GetAddress(1), port);
+    echoClient.SetAttribute("MaxPackets", UintegerValue(100));
+    echoClient.SetAttribute("Interval", TimeValue(MilliSeconds(10)));
+    echoClient.SetAttribute("PacketSize", UintegerValue(512));
+    ApplicationContainer clientApps = echoClient.Install(nodes.Get(0));
+    clientApps.Start(Seconds(1));
+
+    uint32_t received = 0;
+    clientApps.Get(0)->TraceConnectWithoutContext("Rx", MakeBoundCallback(&CountEcho, &received));
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    return {static_cast<double>(received)};
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check that UDP echo replications run by a ReplicationRunner match
+ * separate runs.
+ */
+class UdpEchoReplicationTestCase : public TestCase
+{
+  public:
+    UdpEchoReplicationTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+UdpEchoReplicationTestCase::UdpEchoReplicationTestCase()
+    : TestCase("Test that UDP echo replications match separate runs")
+{
+}
+
+void
+UdpEchoReplicationTestCase::DoRun()
+{
+    ReplicationRunner runner;
+    runner.SetThreads(4);
+    runner.Run(MakeCallback(&UdpEchoScenario), 1, 8);
+    NS_TEST_ASSERT_MSG_EQ(runner.GetN(), 8, "Wrong number of replications");
+
+    uint64_t run = RngSeedManager::GetRun();
+    bool different = false;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        RngSeedManager::SetRun(1 + i);
+        RngSeedManager::ResetNextStreamIndex();
+        std::vector<double> expected = UdpEchoScenario(1 + i);
+        Simulator::Destroy();
+
+        double received = runner.GetResult(i)[0];
+        NS_TEST_EXPECT_MSG_EQ(received, expected[0], "Replication " << i << " differs");
+        NS_TEST_EXPECT_MSG_GT(received, 0, "No echo received");
+        NS_TEST_EXPECT_MSG_LT(received, 100, "No packet lost");
+        different |= (received != runner.GetResult(0)[0]);
+    }
+    RngSeedManager::SetRun(run);
+    NS_TEST_EXPECT_MSG_EQ(different, true, "Runs are not independent");
+}
+
 /**
  * \ingroup applications-test
  * \ingroup tests
@@ -365,6 +486,7 @@ UdpClientServerTestSuite::UdpClientServerTestSuite()
     AddTestCase(new UdpClientServerTestCase, TestCase::Duration::QUICK);
     AddTestCase(new PacketLossCounterTestCase, TestCase::Duration::QUICK);
     AddTestCase(new UdpEchoClientSetFillTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new UdpEchoReplicationTestCase, TestCase::Duration::QUICK);
 }
 
 static UdpClientServerTestSuite
@@ -0,0 +1,152 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replication-runner.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * \ingroup randomvariable
+ * ns3::ReplicationRunner implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplicationRunner");
+
+ReplicationRunner::ReplicationRunner()
+    : m_threads(std::max(1U, std::thread::hardware_concurrency()))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ReplicationRunner::SetThreads(uint32_t threads)
+{
+    NS_LOG_FUNCTION(this << threads);
+    NS_ABORT_MSG_IF(threads == 0, "At least one thread is needed");
+    m_threads = threads;
+}
+
+std::vector<double>
+ReplicationRunner::RunOne(const Scenario& scenario, uint32_t seed, uint64_t run)
+{
+    NS_LOG_FUNCTION(seed << run);
+    RngSeedManager::SetSeed(seed);
+    RngSeedManager::SetRun(run);
+    RngSeedManager::ResetNextStreamIndex();
+    std::vector<double> result = scenario(run);
+    Simulator::Destroy();
+    return result;
+}
+
+void
+ReplicationRunner::Run(const Scenario& scenario, uint64_t firstRun, uint32_t n)
+{
+    NS_LOG_FUNCTION(this << firstRun << n);
+    m_results.assign(n, std::vector<double>());
+    // A seed set by this thread is not seen by the worker threads
+    uint32_t seed = RngSeedManager::GetSeed();
+
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+    // The scenario is shared by reference: copying a Callback from
+    // several threads would race on its reference count
+    std::atomic<uint32_t> next{0};
+    auto worker = [this, &scenario, &next, seed, firstRun, n]() {
+        for (uint32_t i = next++; i < n; i = next++)
+        {
+            m_results[i] = RunOne(scenario, seed, firstRun + i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < std::min(m_threads, n); ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+#else
+    if (m_threads > 1)
+    {
+        NS_LOG_WARN("Replications run sequentially, configure ns-3 with "
+                    "NS3_THREAD_LOCAL_SIMULATION to run them in parallel");
+    }
+    uint64_t run = RngSeedManager::GetRun();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        m_results[i] = RunOne(scenario, seed, firstRun + i);
+    }
+    RngSeedManager::SetRun(run);
+#endif
+}
+
+uint32_t
+ReplicationRunner::GetN() const
+{
+    return m_results.size();
+}
+
+const std::vector<double>&
+ReplicationRunner::GetResult(uint32_t i) const
+{
+    NS_ASSERT_MSG(i < m_results.size(), "No replication " << i);
+    return m_results[i];
+}
+
+double
+ReplicationRunner::GetMean(std::size_t metric) const
+{
+    NS_LOG_FUNCTION(this << metric);
+    NS_ABORT_MSG_IF(m_results.empty(), "No replications were run");
+    double sum = 0;
+    for (const auto& result : m_results)
+    {
+        NS_ABORT_MSG_IF(metric >= result.size(), "Missing metric " << metric);
+        sum += result[metric];
+    }
+    return sum / m_results.size();
+}
+
+double
+ReplicationRunner::GetStddev(std::size_t metric) const
+{
+    NS_LOG_FUNCTION(this << metric);
+    if (m_results.size() < 2)
+    {
+        return 0;
+    }
+    double mean = GetMean(metric);
+    double squares = 0;
+    for (const auto& result : m_results)
+    {
+        squares += (result[metric] - mean) * (result[metric] - mean);
+    }
+    return std::sqrt(squares / (m_results.size() - 1));
+}
+
+} // namespace ns3
@@ -0,0 +1,141 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include "ns3/callback.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * \ingroup randomvariable
+ * ns3::ReplicationRunner declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core-helpers
+ * \ingroup randomvariable
+ *
+ * \brief Run independent replications of a scenario in one process.
+ *
+ * Each replication calls the scenario with its run number, after
+ * RngSeedManager::SetRun() and RngSeedManager::ResetNextStreamIndex(),
+ * so that it draws the same random numbers as a separate process started
+ * with \c --RngRun set to that number.  The seed is the one in effect in
+ * the thread calling Run().  The scenario builds the topology,
+ * calls Simulator::Run() and returns its metrics; the runner then calls
+ * Simulator::Destroy().
+ *
+ * \code
+ *   std::vector<double> Scenario(uint64_t run);
+ *
+ *   ReplicationRunner runner;
+ *   runner.SetThreads(8);
+ *   runner.Run(MakeCallback(&Scenario), 1, 200);
+ *   double throughput = runner.GetMean(0);
+ * \endcode
+ *
+ * When ns-3 is configured with \c NS3_THREAD_LOCAL_SIMULATION, the
+ * replications run on a pool of threads, each with its own simulator,
+ * node list, channel list and random streams.  The scenario must then
+ * only touch state owned by its thread: the Names database, the log
+ * settings and the global and default attribute values are still
+ * shared by the whole process, and should only be read.  Otherwise the
+ * replications run one after the other in the calling thread.
+ */
+class ReplicationRunner
+{
+  public:
+    /**
+     * Callback type of a replication: given the run number, it runs the
+     * simulation and returns its metrics.
+     */
+    typedef Callback<std::vector<double>, uint64_t> Scenario;
+
+    ReplicationRunner();
+
+    /**
+     * Set the number of threads running replications.
+     *
+     * Defaults to the number of hardware threads.  It is ignored unless
+     * ns-3 is configured with \c NS3_THREAD_LOCAL_SIMULATION.
+     *
+     * \param [in] threads The number of threads.
+     */
+    void SetThreads(uint32_t threads);
+
+    /**
+     * Run the replications.
+     *
+     * Any simulation previously set up by the calling thread must have
+     * been destroyed.
+     *
+     * \param [in] scenario The replication to run.
+     * \param [in] firstRun The run number of the first replication.
+     * \param [in] n The number of replications.
+     */
+    void Run(const Scenario& scenario, uint64_t firstRun, uint32_t n);
+
+    /**
+     * \returns The number of replications of the last Run().
+     */
+    uint32_t GetN() const;
+
+    /**
+     * Get the metrics of one replication.
+     * \param [in] i The replication index, counted from the first run.
+     * \returns The metrics returned by the scenario.
+     */
+    const std::vector<double>& GetResult(uint32_t i) const;
+
+    /**
+     * Get the mean of a metric over the replications.
+     * \param [in] metric The index of the metric.
+     * \returns The sample mean.
+     */
+    double GetMean(std::size_t metric) const;
+
+    /**
+     * Get the standard deviation of a metric over the replications.
+     * \param [in] metric The index of the metric.
+     * \returns The sample standard deviation, or 0 with less than two
+     *          replications.
+     */
+    double GetStddev(std::size_t metric) const;
+
+  private:
+    /**
+     * Run one replication in the calling thread.
+     * \param [in] scenario The replication to run.
+     * \param [in] seed The seed, taken from the thread calling Run().
+     * \param [in] run The run number.
+     * \returns The metrics returned by the scenario.
+     */
+    static std::vector<double> RunOne(const Scenario& scenario, uint32_t seed, uint64_t run);
+
+    uint32_t m_threads;                         //!< Number of threads.
+    std::vector<std::vector<double>> m_results; //!< Metrics of each replication.
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
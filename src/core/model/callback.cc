@@ -21,6 +21,8 @@
 
 #include "log.h"
 
+#include <atomic>
+
 /**
  * \file
  * \ingroup callback
@@ -87,6 +89,13 @@ CallbackValue::DeserializeFromString(std::string value, Ptr<const AttributeCheck
 
 ATTRIBUTE_CHECKER_IMPLEMENT(Callback);
 
+uint64_t
+CallbackComponentView::NewIdentity()
+{
+    static std::atomic<uint64_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace ns3
 
 #if (__GNUC__ >= 3)
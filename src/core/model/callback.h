@@ -27,8 +27,12 @@
 #include "ptr.h"
 #include "simple-ref-count.h"
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <new>
+#include <tuple>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -72,6 +76,46 @@ namespace ns3
  * or not we really want to use it.
  */
 
+/**
+ * \ingroup callbackimpl
+ * Type-erased view of a component of a callback, i.e., the callable
+ * object or a bound argument, used to test the equality of callbacks.
+ */
+struct CallbackComponentView
+{
+    /**
+     * Equality test between the values of two components of the same type.
+     *
+     * \param [in] a The first component.
+     * \param [in] b The second component.
+     * \return \c true if the components are equal
+     */
+    typedef bool (*EqualityTest)(const void* a, const void* b);
+
+    const std::type_info* type; //!< The type of the component
+    const void* component;      //!< The component
+    EqualityTest isEqual;       //!< The equality test of the components of this type
+
+    /**
+     * Equality test
+     *
+     * \param [in] other The other component
+     * \return \c true if the components have the same type and compare equal
+     */
+    bool IsEqual(const CallbackComponentView& other) const
+    {
+        return (type == other.type || *type == *other.type) &&
+               isEqual(component, other.component);
+    }
+
+    /**
+     * Get a new identity for a callable object which cannot be compared.
+     *
+     * \return A value never returned before
+     */
+    static uint64_t NewIdentity();
+};
+
 /**
  * \ingroup callbackimpl
  * Abstract base class for CallbackImpl
@@ -97,6 +141,24 @@ class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
      * \return The object type as a string.
      */
     virtual std::string GetTypeid() const = 0;
+    /**
+     * Get the number of components: the callable object, followed by
+     * the bound arguments.
+     * \return The number of components.
+     */
+    virtual std::size_t GetNComponents() const = 0;
+    /**
+     * Get a component.
+     * \param [in] i The index of the component.
+     * \return The view of the component.
+     */
+    virtual CallbackComponentView GetComponent(std::size_t i) const = 0;
+    /**
+     * Copy this implementation into the inline storage of a Callback.
+     * \param [in] storage The storage.
+     * \return The copy.
+     */
+    virtual CallbackImplBase* CopyInto(void* storage) const = 0;
 
   protected:
     /**
@@ -128,39 +190,17 @@ class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
     }
 };
 
-/**
- * \ingroup callbackimpl
- * Abstract base class for CallbackComponent.
- * Provides equality test.
- */
-class CallbackComponentBase
-{
-  public:
-    /** Virtual destructor */
-    virtual ~CallbackComponentBase()
-    {
-    }
-
-    /**
-     * Equality test
-     *
-     * \param [in] other CallbackComponent Ptr
-     * \return \c true if we are equal
-     */
-    virtual bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const = 0;
-};
-
 /**
  * \ingroup callbackimpl
  * Stores a component of a callback, i.e., the callable object
- * or a bound argument. The purpose of this class is to test
- * the equality of the components of two callbacks.
+ * or a bound argument, and tests the equality of the components
+ * of two callbacks.
  *
  * \tparam T The type of the callback component.
  * \tparam isComparable whether this callback component can be compared to others of the same type
  */
 template <typename T, bool isComparable = true>
-class CallbackComponent : public CallbackComponentBase
+class CallbackComponent
 {
   public:
     /**
@@ -173,22 +213,33 @@ class CallbackComponent : public CallbackComponentBase
     {
     }
 
+    /** \return The value of the callback component */
+    T& Get() const
+    {
+        return m_comp;
+    }
+
+    /** \return The view of this component */
+    CallbackComponentView GetView() const
+    {
+        return {&typeid(CallbackComponent), this, &IsEqual};
+    }
+
+  private:
     /**
      * Equality test between the values of two components
      *
-     * \param [in] other CallbackComponentBase Ptr
+     * \param [in] a The first component
+     * \param [in] b The second component
      * \return \c true if we are equal
      */
-    bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const override
+    static bool IsEqual(const void* a, const void* b)
     {
-        auto p = std::dynamic_pointer_cast<const CallbackComponent<T>>(other);
-
-        // other must have the same type and value as ours
-        return !(p == nullptr || p->m_comp != m_comp);
+        return !(static_cast<const CallbackComponent*>(a)->m_comp !=
+                 static_cast<const CallbackComponent*>(b)->m_comp);
     }
 
-  private:
-    T m_comp; //!< the value of the callback component
+    mutable T m_comp; //!< the value of the callback component
 };
 
 /**
@@ -196,14 +247,13 @@ class CallbackComponent : public CallbackComponentBase
  * Partial specialization of class CallbackComponent with isComparable equal
  * to false. This is required to handle callable objects (such as lambdas and
  * objects returned by std::function and std::bind) that do not provide the
- * equality operator. Given that these objects cannot be compared and the only
- * purpose of the class CallbackComponent is to compare values, no object is
- * stored in this specialized class.
+ * equality operator. Such objects only compare equal to their copies, which
+ * share the identity given to the object when the callback was made.
  *
  * \tparam T The type of the callback component.
  */
 template <typename T>
-class CallbackComponent<T, false> : public CallbackComponentBase
+class CallbackComponent<T, false>
 {
   public:
     /**
@@ -212,23 +262,40 @@ class CallbackComponent<T, false> : public CallbackComponentBase
      * \param [in] t The value of the callback component
      */
     CallbackComponent(const T& t)
+        : m_comp(t),
+          m_identity(CallbackComponentView::NewIdentity())
     {
     }
 
+    /** \return The value of the callback component */
+    T& Get() const
+    {
+        return m_comp;
+    }
+
+    /** \return The view of this component */
+    CallbackComponentView GetView() const
+    {
+        return {&typeid(CallbackComponent), this, &IsEqual};
+    }
+
+  private:
     /**
-     * Equality test between functions
+     * Equality test between the identities of two components
      *
-     * \param [in] other CallbackParam Ptr
-     * \return \c true if we are equal
+     * \param [in] a The first component
+     * \param [in] b The second component
+     * \return \c true if one is a copy of the other
      */
-    bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const override
+    static bool IsEqual(const void* a, const void* b)
     {
-        return false;
+        return static_cast<const CallbackComponent*>(a)->m_identity ==
+               static_cast<const CallbackComponent*>(b)->m_identity;
     }
-};
 
-/// Vector of callback components
-typedef std::vector<std::shared_ptr<CallbackComponentBase>> CallbackComponentVector;
+    mutable T m_comp;    //!< the value of the callback component
+    uint64_t m_identity; //!< the identity of the callable object
+};
 
 /**
  * \ingroup callbackimpl
@@ -241,46 +308,13 @@ template <typename R, typename... UArgs>
 class CallbackImpl : public CallbackImplBase
 {
   public:
-    /**
-     * Constructor.
-     *
-     * \param func the callable object
-     * \param components the callback components (callable object and bound arguments)
-     */
-    CallbackImpl(std::function<R(UArgs...)> func, const CallbackComponentVector& components)
-        : m_func(func),
-          m_components(components)
-    {
-    }
-
-    /**
-     * Get the stored function.
-     * \return A const reference to the stored function.
-     */
-    const std::function<R(UArgs...)>& GetFunction() const
-    {
-        return m_func;
-    }
-
-    /**
-     * Get the vector of callback components.
-     * \return A const reference to the vector of callback components.
-     */
-    const CallbackComponentVector& GetComponents() const
-    {
-        return m_components;
-    }
-
     /**
      * Function call operator.
      *
      * \param uargs The arguments to the Callback.
      * \return Callback value
      */
-    R operator()(UArgs... uargs) const
-    {
-        return m_func(uargs...);
-    }
+    virtual R operator()(UArgs... uargs) const = 0;
 
     bool IsEqual(Ptr<const CallbackImplBase> other) const override
     {
@@ -294,23 +328,15 @@ class CallbackImpl : public CallbackImplBase
 
         // if the two callback implementations are made of a distinct number of
         // components, they are different
-        if (m_components.size() != otherDerived->GetComponents().size())
-        {
-            return false;
-        }
-
-        // the two functions are equal if they compare equal or the shared pointers
-        // point to the same locations
-        if (!m_components.at(0)->IsEqual(otherDerived->GetComponents().at(0)) &&
-            m_components.at(0) != otherDerived->GetComponents().at(0))
+        if (GetNComponents() != otherDerived->GetNComponents())
         {
             return false;
         }
 
-        // check if the remaining components are equal one by one
-        for (std::size_t i = 1; i < m_components.size(); i++)
+        // check if the components are equal one by one
+        for (std::size_t i = 0; i < GetNComponents(); i++)
         {
-            if (!m_components.at(i)->IsEqual(otherDerived->GetComponents().at(i)))
+            if (!GetComponent(i).IsEqual(otherDerived->GetComponent(i)))
             {
                 return false;
             }
@@ -343,31 +369,217 @@ class CallbackImpl : public CallbackImplBase
         return id;
     }
 
+  protected:
+    /**
+     * Call a function, discarding its result if the Callback returns void.
+     *
+     * \tparam F \deduced The type of the function.
+     * \tparam Args \deduced The types of the arguments.
+     * \param [in] f The function.
+     * \param [in] args The arguments.
+     * \return Callback value
+     */
+    template <typename F, typename... Args>
+    static R Invoke(F&& f, Args&&... args)
+    {
+        if constexpr (std::is_void_v<R>)
+        {
+            std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+        }
+        else
+        {
+            return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+        }
+    }
+};
+
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl storing a callable object and the values of its
+ * bound arguments.
+ *
+ * This is the generic template declaration (with empty body).
+ *
+ * \tparam T \explicit The type of the callable object.
+ * \tparam BArgs \explicit A tuple of the types of the bound arguments.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
+ */
+template <typename T, typename BArgs, typename R, typename... UArgs>
+class FunctorCallbackImpl;
+
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl storing a callable object and the values of its
+ * bound arguments.
+ *
+ * \tparam T \explicit The type of the callable object.
+ * \tparam BArgs \explicit The types of the bound arguments.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
+ */
+template <typename T, typename... BArgs, typename R, typename... UArgs>
+class FunctorCallbackImpl<T, std::tuple<BArgs...>, R, UArgs...> : public CallbackImpl<R, UArgs...>
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param func the callable object
+     * \param bargs the values of the bound arguments
+     */
+    FunctorCallbackImpl(const T& func, const BArgs&... bargs)
+        : m_func(func),
+          m_bargs(bargs...)
+    {
+    }
+
+    R operator()(UArgs... uargs) const override
+    {
+        return std::apply(
+            [&](auto&... bargs) -> R {
+                if constexpr (std::is_member_function_pointer_v<T> && sizeof...(BArgs) > 0)
+                {
+                    return InvokeMember(bargs.Get()..., std::forward<UArgs>(uargs)...);
+                }
+                else
+                {
+                    return this->Invoke(m_func.Get(), bargs.Get()..., std::forward<UArgs>(uargs)...);
+                }
+            },
+            m_bargs);
+    }
+
+    std::size_t GetNComponents() const override
+    {
+        return 1 + sizeof...(BArgs);
+    }
+
+    CallbackComponentView GetComponent(std::size_t i) const override
+    {
+        if (i == 0)
+        {
+            return m_func.GetView();
+        }
+        return std::apply(
+            [i](const auto&... bargs) {
+                return std::array<CallbackComponentView, sizeof...(BArgs)>{
+                    bargs.GetView()...}[i - 1];
+            },
+            m_bargs);
+    }
+
+    CallbackImplBase* CopyInto(void* storage) const override
+    {
+        return new (storage) FunctorCallbackImpl(*this);
+    }
+
   private:
-    /// Stores the callable object associated with this callback (as a lambda)
-    std::function<R(UArgs...)> m_func;
+    /**
+     * Call a member function on a copy of the bound object pointer.
+     *
+     * The member function may destroy the Callback it is called through
+     * (e.g., a socket closing the end point holding its receive callback),
+     * so the object must not be kept alive by this implementation only.
+     *
+     * \tparam OBJ \deduced The type of the object pointer.
+     * \tparam Args \deduced The types of the other arguments.
+     * \param [in] obj The object pointer.
+     * \param [in] args The other arguments.
+     * \return Callback value
+     */
+    template <typename OBJ, typename... Args>
+    R InvokeMember(OBJ obj, Args&&... args) const
+    {
+        return this->Invoke(m_func.Get(), obj, std::forward<Args>(args)...);
+    }
+
+    /// The original callable object is comparable if it is a function pointer or
+    /// a pointer to a member function or a pointer to a member data.
+    static constexpr bool isComparable =
+        std::is_function_v<std::remove_pointer_t<T>> || std::is_member_pointer_v<T>;
 
-    /// Stores the original callable object and the bound arguments, if any
-    std::vector<std::shared_ptr<CallbackComponentBase>> m_components;
+    /// Stores the callable object
+    CallbackComponent<T, isComparable> m_func;
+
+    /// Stores the bound arguments
+    std::tuple<CallbackComponent<BArgs>...> m_bargs;
 };
 
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl binding the first arguments of another Callback.
+ *
+ * This is the generic template declaration (with empty body).
+ *
+ * \tparam BCallback \explicit The type of the other Callback.
+ * \tparam BArgs \explicit A tuple of the types of the bound arguments.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
+ */
+template <typename BCallback, typename BArgs, typename R, typename... UArgs>
+class BoundCallbackImpl;
+
 /**
  * \ingroup callbackimpl
  * Base class for Callback class.
  * Provides pimpl abstraction.
+ *
+ * Implementations which fit in a few words, such as those of a
+ * function or a member function called on an object pointer with a
+ * bound argument, are stored inline, so that making and copying
+ * callbacks allocate no memory.  Larger implementations are
+ * allocated and shared by the copies of the callback.
  */
 class CallbackBase
 {
   public:
     CallbackBase()
-        : m_impl()
+        : m_impl(nullptr)
     {
     }
 
-    /** \return The impl pointer */
+    /**
+     * Copy constructor
+     * \param [in] other The callback to copy
+     */
+    CallbackBase(const CallbackBase& other)
+        : m_impl(nullptr)
+    {
+        Adopt(other);
+    }
+
+    /**
+     * Copy assignment
+     * \param [in] other The callback to copy
+     * \return This callback
+     */
+    CallbackBase& operator=(const CallbackBase& other)
+    {
+        if (this != &other)
+        {
+            Release();
+            Adopt(other);
+        }
+        return *this;
+    }
+
+    ~CallbackBase()
+    {
+        Release();
+    }
+
+    /**
+     * Get the implementation.
+     *
+     * An implementation stored inline is only valid as long as this
+     * callback.
+     *
+     * \return The impl pointer
+     */
     Ptr<CallbackImplBase> GetImpl() const
     {
-        return m_impl;
+        return Ptr<CallbackImplBase>(m_impl);
     }
 
   protected:
@@ -376,11 +588,76 @@ class CallbackBase
      * \param [in] impl The CallbackImplBase Ptr
      */
     CallbackBase(Ptr<CallbackImplBase> impl)
-        : m_impl(impl)
+        : m_impl(PeekPointer(impl))
+    {
+        if (m_impl != nullptr)
+        {
+            m_impl->Ref();
+        }
+    }
+
+    /**
+     * Construct the implementation, inline if it fits.
+     *
+     * \tparam T \explicit The type of the implementation.
+     * \tparam Args \deduced The types of the constructor arguments.
+     * \param [in] args The constructor arguments.
+     */
+    template <typename T, typename... Args>
+    void Emplace(Args&&... args)
+    {
+        Release();
+        if constexpr (sizeof(T) <= sizeof(m_storage) && alignof(T) <= alignof(void*))
+        {
+            m_impl = new (m_storage) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            m_impl = new T(std::forward<Args>(args)...);
+        }
+    }
+
+    /** Discard the implementation */
+    void Release()
+    {
+        if (IsInline())
+        {
+            m_impl->~CallbackImplBase();
+        }
+        else if (m_impl != nullptr)
+        {
+            m_impl->Unref();
+        }
+        m_impl = nullptr;
+    }
+
+    CallbackImplBase* m_impl; //!< the pimpl
+
+  private:
+    /**
+     * Copy or share the implementation of another callback.
+     * \param [in] other The other callback
+     */
+    void Adopt(const CallbackBase& other)
     {
+        if (other.IsInline())
+        {
+            m_impl = other.m_impl->CopyInto(m_storage);
+        }
+        else if (other.m_impl != nullptr)
+        {
+            m_impl = other.m_impl;
+            m_impl->Ref();
+        }
     }
 
-    Ptr<CallbackImplBase> m_impl; //!< the pimpl
+    /** \return \c true if the implementation is stored inline */
+    bool IsInline() const
+    {
+        return reinterpret_cast<const unsigned char*>(m_impl) == m_storage;
+    }
+
+    alignas(void*) unsigned char m_storage[6 * sizeof(void*)]; //!< the inline pimpl storage
 };
 
 /**
@@ -418,8 +695,9 @@ class CallbackBase
  *   - the pimpl idiom: the Callback class is passed around by
  *     value and delegates the crux of the work to its pimpl
  *     pointer.
- *   - a reference list implementation to implement the Callback's
- *     value semantics.
+ *   - a small buffer to store the pimpl inline when it fits,
+ *     and otherwise a reference list implementation to implement
+ *     the Callback's value semantics.
  *
  * This code most notably departs from the alexandrescu
  * implementation in that it does not use type lists to specify
@@ -464,17 +742,10 @@ class Callback : public CallbackBase
     template <typename... BArgs>
     Callback(const Callback<R, BArgs..., UArgs...>& cb, BArgs... bargs)
     {
-        auto f = cb.DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(cb.DoPeekImpl()->GetComponents());
-        components.insert(components.end(),
-                          {std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        Emplace<BoundCallbackImpl<Callback<R, BArgs..., UArgs...>,
+                                  std::tuple<std::decay_t<BArgs>...>,
+                                  R,
+                                  UArgs...>>(cb, bargs...);
     }
 
     /**
@@ -492,27 +763,13 @@ class Callback : public CallbackBase
     template <typename T,
               typename... BArgs,
               std::enable_if_t<!std::is_base_of_v<CallbackBase, T> &&
-                                   std::is_invocable_r_v<R, T, BArgs..., UArgs...>,
+                                   std::is_invocable_r_v<R, T, std::decay_t<BArgs>&..., UArgs...>,
                                int> = 0>
     Callback(T func, BArgs... bargs)
     {
-        // store the function in a std::function object
-        std::function<R(BArgs..., UArgs...)> f(func);
-
-        // The original function is comparable if it is a function pointer or
-        // a pointer to a member function or a pointer to a member data.
-        constexpr bool isComp =
-            std::is_function_v<std::remove_pointer_t<T>> || std::is_member_pointer_v<T>;
-
-        CallbackComponentVector components(
-            {std::make_shared<CallbackComponent<T, isComp>>(func),
-             std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        Emplace<FunctorCallbackImpl<T, std::tuple<std::decay_t<BArgs>...>, R, UArgs...>>(
+            func,
+            bargs...);
     }
 
   private:
@@ -532,17 +789,13 @@ class Callback : public CallbackBase
     {
         Callback<R, std::tuple_element_t<sizeof...(bargs) + INDEX, std::tuple<UArgs...>>...> cb;
 
-        const auto f = DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(DoPeekImpl()->GetComponents());
-        components.insert(components.end(),
-                          {std::make_shared<CallbackComponent<std::decay_t<BoundArgs>>>(bargs)...});
-
-        cb.m_impl = Create<std::remove_pointer_t<decltype(cb.DoPeekImpl())>>(
-            [f, bargs...](auto&&... uargs) mutable {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        cb.template Emplace<BoundCallbackImpl<
+            Callback,
+            std::tuple<std::decay_t<BoundArgs>...>,
+            R,
+            std::tuple_element_t<sizeof...(bargs) + INDEX, std::tuple<UArgs...>>...>>(
+            *this,
+            std::forward<BoundArgs>(bargs)...);
 
         return cb;
     }
@@ -576,7 +829,7 @@ class Callback : public CallbackBase
     /** Discard the implementation, set it to null */
     void Nullify()
     {
-        m_impl = nullptr;
+        Release();
     }
 
     /**
@@ -631,7 +884,7 @@ class Callback : public CallbackBase
                                 << "expected=" << myTid);
             return false;
         }
-        m_impl = const_cast<CallbackImplBase*>(PeekPointer(otherImpl));
+        CallbackBase::operator=(other);
         return true;
     }
 
@@ -639,7 +892,7 @@ class Callback : public CallbackBase
     /** \return The pimpl pointer */
     CallbackImpl<R, UArgs...>* DoPeekImpl() const
     {
-        return static_cast<CallbackImpl<R, UArgs...>*>(PeekPointer(m_impl));
+        return static_cast<CallbackImpl<R, UArgs...>*>(m_impl);
     }
 
     /**
@@ -659,6 +912,76 @@ class Callback : public CallbackBase
     }
 };
 
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl binding the first arguments of another Callback.
+ *
+ * \tparam BCallback \explicit The type of the other Callback.
+ * \tparam BArgs \explicit The types of the bound arguments.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
+ */
+template <typename BCallback, typename... BArgs, typename R, typename... UArgs>
+class BoundCallbackImpl<BCallback, std::tuple<BArgs...>, R, UArgs...>
+    : public CallbackImpl<R, UArgs...>
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \tparam Args \deduced The types of the values of the bound arguments
+     * \param cb the other callback
+     * \param bargs the values of the bound arguments
+     */
+    template <typename... Args>
+    BoundCallbackImpl(const BCallback& cb, Args&&... bargs)
+        : m_callback(cb),
+          m_bargs(std::forward<Args>(bargs)...)
+    {
+    }
+
+    R operator()(UArgs... uargs) const override
+    {
+        return std::apply(
+            [&](auto&... bargs) -> R {
+                return this->Invoke(m_callback, bargs.Get()..., std::forward<UArgs>(uargs)...);
+            },
+            m_bargs);
+    }
+
+    std::size_t GetNComponents() const override
+    {
+        return m_callback.GetImpl()->GetNComponents() + sizeof...(BArgs);
+    }
+
+    CallbackComponentView GetComponent(std::size_t i) const override
+    {
+        std::size_t n = m_callback.GetImpl()->GetNComponents();
+        if (i < n)
+        {
+            return m_callback.GetImpl()->GetComponent(i);
+        }
+        return std::apply(
+            [i, n](const auto&... bargs) {
+                return std::array<CallbackComponentView, sizeof...(BArgs)>{
+                    bargs.GetView()...}[i - n];
+            },
+            m_bargs);
+    }
+
+    CallbackImplBase* CopyInto(void* storage) const override
+    {
+        return new (storage) BoundCallbackImpl(*this);
+    }
+
+  private:
+    /// The other callback
+    BCallback m_callback;
+
+    /// Stores the bound arguments
+    std::tuple<CallbackComponent<BArgs>...> m_bargs;
+};
+
 /**
  * Inequality test.
  *
@@ -745,6 +1068,33 @@ MakeNullCallback()
     return Callback<R, Args...>();
 }
 
+/**
+ * \ingroup makeboundcallback
+ * Helper for BoundCallbackType, only used in unevaluated contexts.
+ *
+ * \tparam N \explicit The number of bound arguments.
+ * \tparam R \explicit Return type of the callback function.
+ * \tparam Args \explicit Type list of the arguments of the function.
+ * \tparam INDEX \deduced The indices of the arguments left unbound.
+ * \return A callback of the type of the bound callback
+ */
+template <std::size_t N, typename R, typename... Args, std::size_t... INDEX>
+Callback<R, std::tuple_element_t<N + INDEX, std::tuple<Args...>>...> BoundCallbackTypeHelper(
+    std::index_sequence<INDEX...>);
+
+/**
+ * \ingroup makeboundcallback
+ * The type of a Callback calling a function with its first \p N
+ * arguments bound.
+ *
+ * \tparam N \explicit The number of bound arguments.
+ * \tparam R \explicit Return type of the callback function.
+ * \tparam Args \explicit Type list of the arguments of the function.
+ */
+template <std::size_t N, typename R, typename... Args>
+using BoundCallbackType = decltype(BoundCallbackTypeHelper<N, R, Args...>(
+    std::make_index_sequence<sizeof...(Args) - N>{}));
+
 /**
  * \ingroup makeboundcallback
  * @{
@@ -760,7 +1110,7 @@ template <typename R, typename... Args, typename... BArgs>
 auto
 MakeBoundCallback(R (*fnPtr)(Args...), BArgs&&... bargs)
 {
-    return Callback<R, Args...>(fnPtr).Bind(std::forward<BArgs>(bargs)...);
+    return BoundCallbackType<sizeof...(BArgs), R, Args...>(fnPtr, std::forward<BArgs>(bargs)...);
 }
 
 /**
@@ -781,14 +1131,14 @@ template <typename T, typename OBJ, typename R, typename... Args, typename... BA
 auto
 MakeCallback(R (T::*memPtr)(Args...), OBJ objPtr, BArgs... bargs)
 {
-    return Callback<R, Args...>(memPtr, objPtr).Bind(bargs...);
+    return BoundCallbackType<sizeof...(BArgs), R, Args...>(memPtr, objPtr, bargs...);
 }
 
 template <typename T, typename OBJ, typename R, typename... Args, typename... BArgs>
 auto
 MakeCallback(R (T::*memPtr)(Args...) const, OBJ objPtr, BArgs... bargs)
 {
-    return Callback<R, Args...>(memPtr, objPtr).Bind(bargs...);
+    return BoundCallbackType<sizeof...(BArgs), R, Args...>(memPtr, objPtr, bargs...);
 }
 
 /**@}*/
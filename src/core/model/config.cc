@@ -640,6 +640,19 @@ Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& contai
 class ConfigImpl : public Singleton<ConfigImpl>
 {
   public:
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+    /**
+     * Get the instance of the calling thread, so that the root namespace
+     * only holds the node and channel lists of the thread's simulation.
+     * \returns The ConfigImpl of the calling thread.
+     */
+    static ConfigImpl* Get()
+    {
+        static thread_local ConfigImpl impl;
+        return &impl;
+    }
+#endif
+
     // Keep Set and SetFailSafe since their errors are triggered
     // by the underlying ObjectBase functions.
     /** \copydoc ns3::Config::Set() */
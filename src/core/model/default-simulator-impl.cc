@@ -19,12 +19,19 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "double.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
+#include <chrono>
 #include <cmath>
+#include <fstream>
+#include <vector>
 
 /**
  * \file
@@ -45,10 +52,29 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("PurgeThreshold",
+                          "Purge the cancelled events from the event queue when they make up "
+                          "more than this fraction of the queued events (1 never purges).",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&DefaultSimulatorImpl::m_purgeThreshold),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("ProfileSamplingPeriod",
+                          "Time the execution of one event out of this many, and attribute it "
+                          "to the event function and context (0 disables the profiling).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_profileSamplingPeriod),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ProfileFilePrefix",
+                          "The event profile is written at Destroy() to <prefix>.txt, and "
+                          "to <prefix>.folded in the folded stack format of FlameGraph.",
+                          StringValue("event-profile"),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileFilePrefix),
+                          MakeStringChecker());
     return tid;
 }
 
@@ -62,7 +88,8 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_cancelledEvents = 0;
+    m_purgedEvents = 0;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -100,6 +127,23 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    if (m_profiler)
+    {
+        WriteProfile();
+        m_profiler.reset();
+    }
+}
+
+void
+DefaultSimulatorImpl::WriteProfile() const
+{
+    NS_LOG_FUNCTION(this);
+    std::ofstream report(m_profileFilePrefix + ".txt");
+    NS_ABORT_MSG_UNLESS(report.is_open(), "Could not open " << m_profileFilePrefix << ".txt");
+    m_profiler->Report(report);
+    std::ofstream folded(m_profileFilePrefix + ".folded");
+    NS_ABORT_MSG_UNLESS(folded.is_open(), "Could not open " << m_profileFilePrefix << ".folded");
+    m_profiler->WriteFoldedStacks(folded);
 }
 
 void
@@ -136,12 +180,29 @@ DefaultSimulatorImpl::ProcessOneEvent()
     NS_ASSERT(next.key.m_ts >= m_currentTs);
     m_unscheduledEvents--;
     m_eventCount++;
+    if (m_cancelledEvents > 0 && next.impl->IsCancelled())
+    {
+        m_cancelledEvents--;
+    }
 
     NS_LOG_LOGIC("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler && m_profiler->Sample() && !next.impl->IsCancelled())
+    {
+        EventProfiler::Function function = EventProfiler::GetFunction(next.impl);
+        auto start = std::chrono::steady_clock::now();
+        next.impl->Invoke();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        m_profiler->Record(function,
+                           next.key.m_context,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -156,22 +217,12 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    if (m_eventsWithContext.IsEmpty())
     {
         return;
     }
 
-    // swap queues
-    EventsWithContext eventsWithContext;
-    {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
-    }
-    while (!eventsWithContext.empty())
-    {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
+    m_eventsWithContext.PopAll([this](const EventWithContext& event) {
         Scheduler::Event ev;
         ev.impl = event.event;
         ev.key.m_ts = m_currentTs + event.timestamp;
@@ -180,7 +231,7 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
-    }
+    });
 }
 
 void
@@ -191,6 +242,10 @@ DefaultSimulatorImpl::Run()
     m_mainThreadId = std::this_thread::get_id();
     ProcessEventsWithContext();
     m_stop = false;
+    if (m_profileSamplingPeriod > 0 && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>(m_profileSamplingPeriod);
+    }
 
     while (!m_events->IsEmpty() && !m_stop)
     {
@@ -264,11 +319,7 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
-        {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
-        }
+        m_eventsWithContext.Push(ev);
     }
 }
 
@@ -349,10 +400,54 @@ DefaultSimulatorImpl::Remove(const EventId& id)
 void
 DefaultSimulatorImpl::Cancel(const EventId& id)
 {
-    if (!IsExpired(id))
+    if (IsExpired(id))
+    {
+        return;
+    }
+    id.PeekEventImpl()->Cancel();
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        return;
+    }
+    m_cancelledEvents++;
+    if (m_cancelledEvents >= PURGE_MINIMUM &&
+        m_cancelledEvents > m_purgeThreshold * m_unscheduledEvents)
+    {
+        PurgeCancelledEvents();
+    }
+}
+
+void
+DefaultSimulatorImpl::PurgeCancelledEvents()
+{
+    NS_LOG_FUNCTION(this << m_cancelledEvents << m_unscheduledEvents);
+
+    // Schedulers cannot be iterated: empty the event queue, in order, and
+    // insert the live events back, which is cheap for ordered insertions.
+    // Purged events still count as dequeued, so that GetEventCount() does
+    // not depend on the PurgeThreshold.
+    std::vector<Scheduler::Event> live;
+    live.reserve(m_unscheduledEvents);
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event ev = m_events->RemoveNext();
+        if (ev.impl->IsCancelled())
+        {
+            ev.impl->Unref();
+            m_unscheduledEvents--;
+            m_eventCount++;
+            m_purgedEvents++;
+        }
+        else
+        {
+            live.push_back(ev);
+        }
+    }
+    for (const auto& ev : live)
     {
-        id.PeekEventImpl()->Cancel();
+        m_events->Insert(ev);
     }
+    m_cancelledEvents = 0;
 }
 
 bool
@@ -397,4 +492,16 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEvents;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetPurgedEventCount() const
+{
+    return m_purgedEvents;
+}
+
 } // namespace ns3
@@ -20,10 +20,12 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "mpsc-queue.h"
 #include "simulator-impl.h"
 
 #include <list>
-#include <mutex>
+#include <memory>
 #include <thread>
 
 /**
@@ -77,6 +79,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    uint64_t GetCancelledEventCount() const override;
+    uint64_t GetPurgedEventCount() const override;
 
   private:
     void DoDispose() override;
@@ -85,6 +89,10 @@ class DefaultSimulatorImpl : public SimulatorImpl
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
+    /** Remove all the cancelled events from the event queue. */
+    void PurgeCancelledEvents();
+    /** Write the event profile files. */
+    void WriteProfile() const;
 
     /** Wrap an event with its execution context. */
     struct EventWithContext
@@ -97,17 +105,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
-    /** Container type for the events from a different context. */
-    typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
+    /** Container type for the events from a different thread. */
+    typedef MpscQueue<EventWithContext> EventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * The events scheduled from a different thread, waiting to be moved
+     * to the primary event queue by the main thread.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    EventsWithContext m_eventsWithContext;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -128,6 +132,14 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t m_currentContext;
     /** The event count. */
     uint64_t m_eventCount;
+    /** Number of cancelled events in the event queue. */
+    uint64_t m_cancelledEvents;
+    /** Number of cancelled events purged before they came due. */
+    uint64_t m_purgedEvents;
+    /** Fraction of cancelled events in the event queue which triggers a purge. */
+    double m_purgeThreshold;
+    /** Number of cancelled events below which the event queue is never purged. */
+    static constexpr uint64_t PURGE_MINIMUM = 1024;
     /**
      * Number of events that have been inserted but not yet scheduled,
      *  not counting the Destroy events; this is used for validation
@@ -136,6 +148,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Time one event out of this many, or none if zero. */
+    uint32_t m_profileSamplingPeriod;
+    /** Prefix of the event profile files. */
+    std::string m_profileFilePrefix;
+    /** The event profiler, if profiling is enabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
@@ -21,6 +21,9 @@
 
 #include "log.h"
 
+#include <array>
+#include <mutex>
+
 /**
  * \file
  * \ingroup events
@@ -67,4 +70,216 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+const void*
+EventImpl::GetFunction() const
+{
+    return nullptr;
+}
+
+#ifdef EVENT_IMPL_FREE_LIST
+
+namespace
+{
+
+/** Granularity of the event size classes, in bytes. */
+constexpr std::size_t POOL_GRANULARITY = 16;
+/** Number of size classes; larger events use the system allocator. */
+constexpr std::size_t POOL_CLASSES = 16;
+/** Maximum number of blocks kept per size class, in each thread. */
+constexpr std::size_t POOL_MAX_CACHED = 4096;
+
+/** A free block, linked through its own storage. */
+struct FreeBlock
+{
+    FreeBlock* next; /**< Next free block of the same size class. */
+};
+
+/**
+ * The free lists and counters of one thread.
+ *
+ * Blocks are allocated one at a time with the system allocator, so that
+ * a block freed by another thread than the one which allocated it can
+ * be kept, or released, by the freeing thread.
+ */
+class EventPool
+{
+  public:
+    EventPool();
+    /** Release the cached blocks and record the counters of this thread. */
+    ~EventPool();
+
+    /**
+     * Allocate a block.
+     * \param [in] size The size of the event.
+     * \returns The block.
+     */
+    void* Allocate(std::size_t size);
+    /**
+     * Release a block.
+     * \param [in] p The block.
+     * \param [in] size The size of the event.
+     */
+    void Deallocate(void* p, std::size_t size);
+
+    EventImpl::PoolStats m_stats; /**< Counters of this thread. */
+
+  private:
+    std::array<FreeBlock*, POOL_CLASSES> m_heads;    /**< Free lists, per size class. */
+    std::array<std::size_t, POOL_CLASSES> m_lengths; /**< Free list lengths. */
+};
+
+/** Protects g_exitedStats. */
+std::mutex g_exitedMutex;
+/** Counters of the threads which have exited. */
+EventImpl::PoolStats g_exitedStats{};
+/** Whether the pool of this thread has already been destroyed. */
+thread_local bool g_poolDestroyed = false;
+
+/**
+ * Get the pool of the calling thread.
+ * \returns The pool.
+ */
+EventPool&
+GetPool()
+{
+    thread_local EventPool pool;
+    return pool;
+}
+
+EventPool::EventPool()
+    : m_stats{},
+      m_heads{},
+      m_lengths{}
+{
+}
+
+EventPool::~EventPool()
+{
+    for (auto head : m_heads)
+    {
+        while (head != nullptr)
+        {
+            FreeBlock* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+    m_stats.cached = 0;
+    g_poolDestroyed = true;
+
+    std::unique_lock lock{g_exitedMutex};
+    g_exitedStats.allocations += m_stats.allocations;
+    g_exitedStats.reused += m_stats.reused;
+    g_exitedStats.oversize += m_stats.oversize;
+    g_exitedStats.deallocations += m_stats.deallocations;
+}
+
+void*
+EventPool::Allocate(std::size_t size)
+{
+    m_stats.allocations++;
+    std::size_t index = (size - 1) / POOL_GRANULARITY;
+    if (index >= POOL_CLASSES)
+    {
+        m_stats.oversize++;
+        return ::operator new(size);
+    }
+    FreeBlock* block = m_heads[index];
+    if (block == nullptr)
+    {
+        return ::operator new((index + 1) * POOL_GRANULARITY);
+    }
+    m_heads[index] = block->next;
+    m_lengths[index]--;
+    m_stats.cached--;
+    m_stats.reused++;
+    return block;
+}
+
+void
+EventPool::Deallocate(void* p, std::size_t size)
+{
+    m_stats.deallocations++;
+    std::size_t index = (size - 1) / POOL_GRANULARITY;
+    if (index >= POOL_CLASSES || m_lengths[index] >= POOL_MAX_CACHED)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = m_heads[index];
+    m_heads[index] = block;
+    m_lengths[index]++;
+    m_stats.cached++;
+}
+
+} // unnamed namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    if (g_poolDestroyed)
+    {
+        return ::operator new(size);
+    }
+    return GetPool().Allocate(size);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    if (g_poolDestroyed)
+    {
+        ::operator delete(p);
+        return;
+    }
+    GetPool().Deallocate(p, size);
+}
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats()
+{
+    PoolStats stats = g_poolDestroyed ? PoolStats{} : GetPool().m_stats;
+    std::unique_lock lock{g_exitedMutex};
+    stats.allocations += g_exitedStats.allocations;
+    stats.reused += g_exitedStats.reused;
+    stats.oversize += g_exitedStats.oversize;
+    stats.deallocations += g_exitedStats.deallocations;
+    return stats;
+}
+
+#else /* EVENT_IMPL_FREE_LIST */
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    ::operator delete(p, size);
+}
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats()
+{
+    return PoolStats{};
+}
+
+#endif /* EVENT_IMPL_FREE_LIST */
+
+void*
+EventImpl::operator new(std::size_t size, std::align_val_t align)
+{
+    return ::operator new(size, align);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size, std::align_val_t align)
+{
+    ::operator delete(p, size, align);
+}
+
 } // namespace ns3
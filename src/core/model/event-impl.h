@@ -21,8 +21,19 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
+#include <new>
 #include <stdint.h>
 
+/**
+ * \ingroup events
+ * Recycle the memory of events through per-thread free lists.
+ *
+ * Comment out to hand every event back to the system allocator,
+ * for instance when looking for memory errors with valgrind.
+ */
+#define EVENT_IMPL_FREE_LIST 1
+
 /**
  * \file
  * \ingroup events
@@ -66,6 +77,77 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get the address of the code run by this event.
+     *
+     * The event profiler uses it to tell the event functions apart.
+     * Call it before the event runs: a virtual member function is
+     * looked up in its object, which the event may destroy.
+     *
+     * \returns The function address, or \c nullptr if unknown,
+     *          as for lambdas.
+     */
+    virtual const void* GetFunction() const;
+
+    /**
+     * Allocate the memory of an event.
+     *
+     * Events are allocated once per Simulator::Schedule() call and
+     * released right after they run, so their memory is recycled
+     * through per-thread free lists, one per size class.  Events too
+     * large for any size class use the system allocator.
+     *
+     * \param [in] size The size of the event.
+     * \returns The memory block.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release the memory of an event.
+     *
+     * The block is kept in the free list of the calling thread,
+     * whichever thread allocated it.
+     *
+     * \param [in] p The memory block.
+     * \param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * Allocate the memory of an over-aligned event,
+     * with the system allocator.
+     *
+     * \param [in] size The size of the event.
+     * \param [in] align The alignment of the event.
+     * \returns The memory block.
+     */
+    static void* operator new(std::size_t size, std::align_val_t align);
+    /**
+     * Release the memory of an over-aligned event.
+     *
+     * \param [in] p The memory block.
+     * \param [in] size The size of the event.
+     * \param [in] align The alignment of the event.
+     */
+    static void operator delete(void* p, std::size_t size, std::align_val_t align);
+
+    /** Event allocator counters. */
+    struct PoolStats
+    {
+        uint64_t allocations;   /**< Number of events allocated. */
+        uint64_t reused;        /**< Allocations served from a free list. */
+        uint64_t oversize;      /**< Allocations too large for the free lists. */
+        uint64_t deallocations; /**< Number of events released. */
+        uint64_t cached;        /**< Blocks currently held in the free lists. */
+    };
+
+    /**
+     * Get the event allocator counters.
+     *
+     * The counters are those of the calling thread, plus those of the
+     * threads which have already exited.
+     *
+     * \returns The counters.
+     */
+    static PoolStats GetPoolStats();
 
   protected:
     /**
@@ -0,0 +1,258 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+#include <vector>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#ifndef __WIN32__
+#include <dlfcn.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+EventProfiler::EventProfiler(uint32_t period)
+    : m_period(period),
+      m_countdown(period)
+{
+    NS_LOG_FUNCTION(this << period);
+    NS_ASSERT(period > 0);
+}
+
+EventProfiler::Function
+EventProfiler::GetFunction(const EventImpl* event)
+{
+    return Function(typeid(*event), event->GetFunction());
+}
+
+void
+EventProfiler::Record(const Function& function, uint32_t context, int64_t nanoseconds)
+{
+    Samples& samples = m_samples[std::make_pair(context, function)];
+    samples.count++;
+    samples.nanoseconds += nanoseconds;
+}
+
+std::string
+EventProfiler::GetEventName(const EventImpl* event)
+{
+    return GetFunctionName(GetFunction(event));
+}
+
+/**
+ * \ingroup simulator
+ * Demangle a C++ symbol or type name.
+ * \param [in] name The mangled name.
+ * \returns The demangled name, or \p name if it cannot be demangled.
+ */
+static std::string
+Demangle(const char* name)
+{
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        std::string result = demangled;
+        std::free(demangled);
+        return result;
+    }
+#endif
+    return name;
+}
+
+std::string
+EventProfiler::GetFunctionName(const Function& function)
+{
+    const auto& [type, address] = function;
+    if (address == nullptr)
+    {
+        return GetTypeName(type);
+    }
+#ifndef __WIN32__
+    Dl_info info;
+    if (dladdr(address, &info) != 0 && info.dli_sname != nullptr && info.dli_saddr == address)
+    {
+        return Demangle(info.dli_sname);
+    }
+#endif
+    std::ostringstream oss;
+    oss << GetTypeName(type) << " at " << address;
+    return oss.str();
+}
+
+std::string
+EventProfiler::GetTypeName(std::type_index type)
+{
+    std::string name = Demangle(type.name());
+
+    // The events of MakeEvent() are local classes of the function template,
+    // whose first parameter is the scheduled function: keep only its type
+    const std::string prefix = "ns3::MakeEvent<";
+    if (name.compare(0, prefix.size(), prefix) != 0)
+    {
+        return name;
+    }
+    int depth = 0;
+    std::size_t start = std::string::npos;
+    for (std::size_t i = prefix.size() - 1; i < name.size(); ++i)
+    {
+        char c = name[i];
+        if (depth == 0 && start == std::string::npos && c == '(')
+        {
+            start = i + 1;
+            continue;
+        }
+        if (depth == 0 && start != std::string::npos && (c == ',' || c == ')'))
+        {
+            return name.substr(start, i - start);
+        }
+        if (c == '<' || c == '(' || c == '{' || c == '[')
+        {
+            depth++;
+        }
+        else if (c == '>' || c == ')' || c == '}' || c == ']')
+        {
+            depth--;
+        }
+    }
+    return name;
+}
+
+std::string
+EventProfiler::GetContextName(uint32_t context)
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return "no context";
+    }
+    return "node " + std::to_string(context);
+}
+
+/**
+ * \ingroup simulator
+ * Write one table of the event profile.
+ * \param [in,out] os The output stream.
+ * \param [in] title The table title.
+ * \param [in] rows The estimated wall time in nanoseconds and event
+ *             count of each row, by row name.
+ * \param [in] total The total estimated wall time in nanoseconds.
+ */
+static void
+WriteProfileTable(std::ostream& os,
+                  const std::string& title,
+                  const std::map<std::string, std::pair<int64_t, uint64_t>>& rows,
+                  int64_t total)
+{
+    std::vector<std::pair<std::string, std::pair<int64_t, uint64_t>>> sorted(rows.begin(),
+                                                                               rows.end());
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.first > b.second.first;
+    });
+
+    os << title << std::endl;
+    os << std::setw(8) << "share" << std::setw(14) << "time (s)" << std::setw(14) << "events"
+       << std::setw(12) << "ns/event"
+       << "  name" << std::endl;
+    for (const auto& [name, row] : sorted)
+    {
+        const auto& [nanoseconds, count] = row;
+        os << std::fixed << std::setprecision(1) << std::setw(7)
+           << (total > 0 ? 100.0 * nanoseconds / total : 0.0) << "%" << std::setprecision(6)
+           << std::setw(14) << nanoseconds * 1e-9 << std::setw(14) << count << std::setprecision(0)
+           << std::setw(12) << static_cast<double>(nanoseconds) / count << "  " << name
+           << std::endl;
+    }
+    os << std::defaultfloat << std::endl;
+}
+
+void
+EventProfiler::Report(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    std::map<Function, std::string> names;
+    std::map<std::string, std::pair<int64_t, uint64_t>> functions;
+    std::map<std::string, std::pair<int64_t, uint64_t>> contexts;
+    int64_t total = 0;
+    uint64_t samples = 0;
+    for (const auto& [key, value] : m_samples)
+    {
+        const auto& [context, function] = key;
+        auto it = names.find(function);
+        if (it == names.end())
+        {
+            it = names.emplace(function, GetFunctionName(function)).first;
+        }
+        int64_t nanoseconds = value.nanoseconds * m_period;
+        uint64_t count = value.count * m_period;
+        auto& row = functions[it->second];
+        row.first += nanoseconds;
+        row.second += count;
+        auto& node = contexts[GetContextName(context)];
+        node.first += nanoseconds;
+        node.second += count;
+        total += nanoseconds;
+        samples += value.count;
+    }
+
+    os << "Event profile: " << samples << " events timed, 1 in " << m_period
+       << "; times and counts below are estimates" << std::endl
+       << std::endl;
+    WriteProfileTable(os, "Wall time by event function", functions, total);
+    WriteProfileTable(os, "Wall time by context", contexts, total);
+}
+
+void
+EventProfiler::WriteFoldedStacks(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    std::map<Function, std::string> names;
+    for (const auto& [key, value] : m_samples)
+    {
+        const auto& [context, function] = key;
+        auto it = names.find(function);
+        if (it == names.end())
+        {
+            it = names.emplace(function, GetFunctionName(function)).first;
+        }
+        os << GetContextName(context) << ";" << it->second << " "
+           << value.nanoseconds * m_period << std::endl;
+    }
+}
+
+} // namespace ns3
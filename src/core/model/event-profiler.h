@@ -0,0 +1,165 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <map>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \brief Sampling wall-clock profiler of the event handlers.
+ *
+ * Where DesMetrics records when events are scheduled, this class
+ * records how long they take to run.  The simulator implementation asks
+ * Sample() before each event; one event in \c period is timed, and
+ * its wall time is attributed to the event function and to the context
+ * (the node id) of the event.  The totals are estimated by scaling the
+ * samples by the period.
+ *
+ * The events are told apart by the address of the function or member
+ * function they run, and by the dynamic type of the EventImpl for the
+ * lambdas.  The addresses are named after the symbols of the shared
+ * libraries, found with dladdr(); a function which is not exported, such
+ * as a static function, is named after its type and address.
+ *
+ * DefaultSimulatorImpl uses this class when its \c ProfileSamplingPeriod
+ * attribute is not zero.
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] period Time one event out of \p period.
+     */
+    EventProfiler(uint32_t period);
+
+    /**
+     * Check if the next event should be timed.
+     * \returns \c true once every \c period calls.
+     */
+    bool Sample()
+    {
+        if (--m_countdown == 0)
+        {
+            m_countdown = m_period;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * The function run by an event: the dynamic type of the event and
+     * the address of the function, if known.
+     */
+    typedef std::pair<std::type_index, const void*> Function;
+
+    /**
+     * Get the function run by an event.
+     *
+     * Call it before the event runs, see EventImpl::GetFunction().
+     *
+     * \param [in] event The event.
+     * \returns The function.
+     */
+    static Function GetFunction(const EventImpl* event);
+
+    /**
+     * Record a timed event.
+     * \param [in] function The function the event ran.
+     * \param [in] context The context of the event.
+     * \param [in] nanoseconds The wall time the event took.
+     */
+    void Record(const Function& function, uint32_t context, int64_t nanoseconds);
+
+    /**
+     * Write the estimated wall time and event counts per event function
+     * and per context, by decreasing wall time.
+     * \param [in,out] os The output stream.
+     */
+    void Report(std::ostream& os) const;
+
+    /**
+     * Write the estimated wall time in nanoseconds in the folded stack
+     * format of the FlameGraph tools, with one "context;function" stack
+     * per line.
+     * \param [in,out] os The output stream.
+     */
+    void WriteFoldedStacks(std::ostream& os) const;
+
+    /**
+     * Get the name of the function run by an event.
+     * \param [in] event The event.
+     * \returns The function name.
+     */
+    static std::string GetEventName(const EventImpl* event);
+
+  private:
+    /**
+     * Get the name of a function run by events.
+     * \param [in] function The function.
+     * \returns The function name.
+     */
+    static std::string GetFunctionName(const Function& function);
+
+    /**
+     * Get the name of a function from the type of its event.
+     * \param [in] type The dynamic type of the EventImpl.
+     * \returns The type of the function pointer, or of the event.
+     */
+    static std::string GetTypeName(std::type_index type);
+
+    /**
+     * Get the name of a context.
+     * \param [in] context The context.
+     * \returns "node N", or "no context".
+     */
+    static std::string GetContextName(uint32_t context);
+
+    /** Samples of one event function in one context. */
+    struct Samples
+    {
+        uint64_t count{0};      //!< Number of timed events.
+        int64_t nanoseconds{0}; //!< Total wall time of the timed events.
+    };
+
+    /** Sample container, indexed by context and event function. */
+    typedef std::map<std::pair<uint32_t, Function>, Samples> SampleMap;
+
+    uint32_t m_period;    //!< Sampling period, in events.
+    uint32_t m_countdown; //!< Events left before the next sample.
+    SampleMap m_samples;  //!< The samples.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
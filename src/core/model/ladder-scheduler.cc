@@ -0,0 +1,269 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+uint64_t
+LadderScheduler::Rung::CurrentStart() const
+{
+    return start + current * width;
+}
+
+std::size_t
+LadderScheduler::Rung::Index(uint64_t ts) const
+{
+    return (ts - start) / width;
+}
+
+void
+LadderScheduler::Rung::Reset(uint64_t rungStart, uint64_t span, std::size_t events)
+{
+    start = rungStart;
+    width = std::max<uint64_t>(1, (span + events - 1) / events);
+    count = (span + width - 1) / width;
+    current = 0;
+    if (buckets.size() < count)
+    {
+        buckets.resize(count);
+    }
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_topStart(0),
+      m_nRungs(0),
+      m_bottomFill(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::Bucket*
+LadderScheduler::Locate(uint64_t ts)
+{
+    if (ts >= m_topStart)
+    {
+        return &m_top;
+    }
+    for (std::size_t i = 0; i < m_nRungs; ++i)
+    {
+        Rung& rung = m_rungs[i];
+        if (ts >= rung.CurrentStart())
+        {
+            return &rung.buckets[rung.Index(ts)];
+        }
+    }
+    return nullptr;
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    Bucket* bucket = Locate(ev.key.m_ts);
+    if (bucket == &m_top)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ev.key.m_ts);
+        m_topMax = std::max(m_topMax, ev.key.m_ts);
+    }
+    else if (bucket != nullptr)
+    {
+        bucket->push_back(ev);
+    }
+    else
+    {
+        InsertBottom(ev);
+    }
+    if (m_bottom.empty())
+    {
+        FillBottom();
+    }
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    auto pos = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+    m_bottom.insert(pos, ev);
+
+    // Too many events have piled up below the ladder since it was last
+    // visited: spread them over a new rung, unless they cannot be split.
+    if (m_bottom.size() > std::max(THRESHOLD, 2 * m_bottomFill) && m_nRungs < MAX_RUNGS &&
+        m_bottom.front().key.m_ts != m_bottom.back().key.m_ts)
+    {
+        uint64_t start = m_bottom.back().key.m_ts;
+        uint64_t end = m_nRungs > 0 ? m_rungs[m_nRungs - 1].CurrentStart() : m_topStart;
+        Bucket events;
+        events.swap(m_bottom);
+        Spawn(events, start, end - start);
+        m_bottom.swap(events);
+        FillBottom();
+    }
+}
+
+void
+LadderScheduler::Spawn(Bucket& events, uint64_t start, uint64_t span)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << span);
+    NS_ASSERT(m_nRungs < MAX_RUNGS);
+    Rung& rung = m_rungs[m_nRungs];
+    m_nRungs++;
+    rung.Reset(start, span, events.size());
+    for (const auto& ev : events)
+    {
+        rung.buckets[rung.Index(ev.key.m_ts)].push_back(ev);
+    }
+    events.clear();
+}
+
+void
+LadderScheduler::FillBottom()
+{
+    NS_LOG_FUNCTION(this);
+    while (m_bottom.empty())
+    {
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            Spawn(m_top, m_topMin, m_topMax - m_topMin + 1);
+            m_topStart = m_rungs[0].start + m_rungs[0].count * m_rungs[0].width;
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        while (rung.current < rung.count && rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        if (rung.current == rung.count)
+        {
+            m_nRungs--;
+            continue;
+        }
+
+        Bucket& bucket = rung.buckets[rung.current];
+        uint64_t bucketStart = rung.CurrentStart();
+        rung.current++;
+        if (bucket.size() > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+            Spawn(bucket, bucketStart, rung.width);
+            continue;
+        }
+        m_bottom.swap(bucket);
+        std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+        m_bottomFill = m_bottom.size();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    return m_bottom.empty();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    if (m_bottom.empty())
+    {
+        FillBottom();
+    }
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    Bucket* bucket = Locate(ev.key.m_ts);
+    if (bucket == nullptr)
+    {
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+        NS_ASSERT(it != m_bottom.end() && *it == ev);
+        m_bottom.erase(it);
+    }
+    else
+    {
+        auto it = std::find(bucket->begin(), bucket->end(), ev);
+        NS_ASSERT(it != bucket->end());
+        *it = bucket->back();
+        bucket->pop_back();
+        if (m_top.empty())
+        {
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+        }
+    }
+    if (m_bottom.empty())
+    {
+        FillBottom();
+    }
+}
+
+} // namespace ns3
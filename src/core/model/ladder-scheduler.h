@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <array>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler is a direct implementation of the Ladder Queue
+ * described in:
+ *
+ * W. T. Tang, R. S. M. Goh and I. L.-J. Thng,
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation", ACM TOMACS 15(3), 2005.
+ *
+ * Events are kept in three tiers:
+ *
+ *  - Top: an unsorted vector of the farthest events, later than
+ *    every event stored below it;
+ *  - Ladder: up to eight rungs of buckets.  The first rung is built
+ *    from Top when the lower tiers run dry, using as many buckets as
+ *    there are events; the bucket which is due next is split into a
+ *    finer rung if it holds too many events;
+ *  - Bottom: a small sorted vector holding the next events.
+ *
+ * Only Bottom is ever sorted, and only a handful of events at a time,
+ * so the queue adapts itself to the timestamp distribution without the
+ * explicit resize heuristics of the CalendarScheduler.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or a bucket; sorted insertion into a short Bottom
+ * IsEmpty()    | Constant        | Bottom is never empty when there are events
+ * PeekNext()   | Constant        | Last element of Bottom
+ * Remove()     | Linear          | Search within Top or a bucket
+ * RemoveNext() | ~Constant       | Each event is moved at most once per rung
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                              | Reason
+ * :-------- | :---------------------------------- | :-----
+ * Overhead  | 8 rungs of `std::vector` of buckets | Rung storage is reused
+ * Per Event | 0                                   | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Unsorted container of events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** One rung of the ladder. */
+    struct Rung
+    {
+        uint64_t start;              /**< Timestamp of the start of the first bucket. */
+        uint64_t width;              /**< Width of each bucket. */
+        std::size_t current;         /**< Index of the next bucket to visit. */
+        std::size_t count;           /**< Number of buckets in use. */
+        std::vector<Bucket> buckets; /**< The buckets, possibly more than \c count. */
+
+        /**
+         * Get the start of the next bucket to visit.
+         * \returns The timestamp of the start of the current bucket.
+         */
+        uint64_t CurrentStart() const;
+        /**
+         * Get the bucket of a timestamp.
+         * \param [in] ts The timestamp.
+         * \returns The bucket index.
+         */
+        std::size_t Index(uint64_t ts) const;
+        /**
+         * Prepare the rung for a new range of timestamps.
+         * \param [in] rungStart The start of the first bucket.
+         * \param [in] span The width of the range to cover.
+         * \param [in] events The number of events to spread.
+         */
+        void Reset(uint64_t rungStart, uint64_t span, std::size_t events);
+    };
+
+    /**
+     * Find the container an event with a given timestamp belongs to.
+     *
+     * \param [in] ts The event timestamp.
+     * \returns The Top or rung bucket, or \c nullptr for Bottom.
+     */
+    Bucket* Locate(uint64_t ts);
+    /**
+     * Insert an event into Bottom, keeping it sorted.
+     *
+     * \param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+    /**
+     * Spread events over a new rung.
+     *
+     * \param [in] events The events to move, which is cleared.
+     * \param [in] start The start of the range of the new rung.
+     * \param [in] span The width of the range of the new rung.
+     */
+    void Spawn(Bucket& events, uint64_t start, uint64_t span);
+    /** Refill an empty Bottom from the ladder, or from Top. */
+    void FillBottom();
+
+    /** Bucket size above which a new rung is spawned. */
+    static constexpr std::size_t THRESHOLD = 50;
+    /** Maximum number of rungs. */
+    static constexpr std::size_t MAX_RUNGS = 8;
+
+    Bucket m_top;        /**< Unsorted events later than any other tier. */
+    uint64_t m_topMin;   /**< Smallest timestamp in Top. */
+    uint64_t m_topMax;   /**< Largest timestamp in Top. */
+    uint64_t m_topStart; /**< Events at or after this timestamp go to Top. */
+
+    std::array<Rung, MAX_RUNGS> m_rungs; /**< The ladder. */
+    std::size_t m_nRungs;                /**< Number of rungs in use. */
+
+    /** Next events, sorted in reverse chronological order. */
+    Bucket m_bottom;
+    /** Size of Bottom when last filled, to bound rung spawning from it. */
+    std::size_t m_bottomFill;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
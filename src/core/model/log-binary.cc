@@ -0,0 +1,938 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "log-binary.h"
+
+#include "environment-variable.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "node-printer.h"
+#include "nstime.h"
+#include "simulator.h"
+#include "time-printer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup logbinary
+ * ns3::LogBinaryRecord and the binary log sink implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup logbinary
+ * Unnamed namespace for log-binary.cc
+ */
+namespace
+{
+
+/** The magic number starting a binary log file. */
+const char LOG_BINARY_MAGIC[8] = {'N', 'S', '3', 'B', 'L', 'O', 'G', '1'};
+
+/**
+ * Kinds of the records of a binary log file.
+ *
+ * Every record starts with its size (4 bytes, including the size)
+ * and its kind (1 byte).
+ */
+enum RecordKind : uint8_t
+{
+    RECORD_SITE = 1, //!< A call site: identifier, function flag, component and function names.
+    RECORD_MESSAGE   //!< A log message: call site, level, prefixes and values.
+};
+
+/** Prefixes written in a message record. */
+enum RecordPrefix : uint8_t
+{
+    PREFIX_TIME = 1 << 0,  //!< The simulation time.
+    PREFIX_NODE = 1 << 1,  //!< The node id.
+    PREFIX_FUNC = 1 << 2,  //!< The component and function names.
+    PREFIX_LEVEL = 1 << 3, //!< The severity level.
+};
+
+/** How a time or node prefix is written. */
+enum PrefixFormat : uint8_t
+{
+    PREFIX_RAW = 0, //!< The value, as the default printer prints it.
+    PREFIX_TEXT     //!< The text written by a custom printer.
+};
+
+/** Size of the ring buffer of each logging thread. */
+constexpr std::size_t LOG_BINARY_RING_SIZE = 1 << 20;
+
+/** Interval between two writes of the buffered records. */
+constexpr std::chrono::milliseconds LOG_BINARY_DRAIN_INTERVAL{10};
+
+/** The stream flags of a record stream before any manipulator. */
+constexpr std::ios_base::fmtflags LOG_BINARY_DEFAULT_FLAGS =
+    std::ios_base::boolalpha | std::ios_base::dec | std::ios_base::skipws;
+
+/**
+ * State of a logging thread.
+ *
+ * The records are built in a buffer, and then copied to a single
+ * producer, single consumer ring of bytes emptied by the drain thread.
+ * The state is owned by the sink rather than being \c thread_local, so
+ * that it outlives the thread until its records are written, and so
+ * that messages logged by the destructors of static objects are not
+ * lost.
+ */
+struct LogBinaryThread
+{
+    std::unique_ptr<char[]> ring{new char[LOG_BINARY_RING_SIZE]}; //!< The ring.
+    std::atomic<uint64_t> head{0}; //!< Bytes written, updated by the producer.
+    std::atomic<uint64_t> tail{0}; //!< Bytes consumed, updated by the consumer.
+    std::string buffer;            //!< The records being built.
+    /** The streams formatting values, one per nesting depth of the records. */
+    std::vector<std::unique_ptr<std::ostringstream>> streams;
+    std::size_t depth{0}; //!< The nesting depth of the records being built.
+};
+
+/** Whether the binary sink is enabled. */
+std::atomic<bool> g_logBinaryEnabled{false};
+
+/**
+ * The binary log file, the rings of the logging threads and the thread
+ * writing their records to the file.
+ */
+class LogBinarySink
+{
+  public:
+    /**
+     * Get the sink.
+     * \returns The sink.
+     */
+    static LogBinarySink& Get();
+
+    /** Destructor, closes the file. */
+    ~LogBinarySink();
+
+    /**
+     * Open the file and start the drain thread.
+     * \param [in] filename The name of the file.
+     */
+    void Enable(const std::string& filename);
+    /** Write the buffered records, stop the drain thread and close the file. */
+    void Disable();
+    /**
+     * Register a call site.
+     * \param [in] component The component name.
+     * \param [in] function The function name.
+     * \param [in] isFunction Whether the site is a NS_LOG_FUNCTION() one.
+     * \returns The call site identifier.
+     */
+    uint32_t RegisterSite(const std::string& component, const char* function, bool isFunction);
+    /**
+     * Write a record to the ring of the calling thread.
+     * \param [in] data The record.
+     * \param [in] size The size of the record.
+     */
+    void Commit(const char* data, std::size_t size);
+    /**
+     * Get the state of the calling thread, registering it if needed.
+     * \returns The state.
+     */
+    LogBinaryThread& GetThread();
+
+  private:
+    /** Drain thread body. */
+    void Run();
+    /** Write the new call sites and the buffered records, with m_mutex held. */
+    void DrainLocked();
+
+    std::mutex m_mutex;                                 //!< Protects everything below.
+    std::condition_variable m_cv;                       //!< Wakes the drain thread.
+    std::vector<std::unique_ptr<LogBinaryThread>> m_threads; //!< The logging threads.
+    std::vector<std::string> m_sites;                   //!< Encoded records of the call sites.
+    std::size_t m_sitesWritten{0};                      //!< Call sites written to the file.
+    std::ofstream m_file;                               //!< The binary log file.
+    std::thread m_thread;                               //!< The drain thread.
+    bool m_stop{false};                                 //!< Tells the drain thread to stop.
+};
+
+/** The state of the calling thread. */
+thread_local LogBinaryThread* t_logBinaryThread = nullptr;
+
+/**
+ * Get the stream of a new record of the calling thread.
+ * \returns The stream, with the format of \c std::clog in log messages.
+ */
+std::ostringstream&
+AcquireStream()
+{
+    LogBinaryThread& thread = LogBinarySink::Get().GetThread();
+    if (thread.streams.size() <= thread.depth)
+    {
+        thread.streams.emplace_back(std::make_unique<std::ostringstream>());
+    }
+    std::ostringstream& os = *thread.streams[thread.depth++];
+    os.str("");
+    os.clear();
+    os.flags(LOG_BINARY_DEFAULT_FLAGS);
+    os.precision(6);
+    os.width(0);
+    os.fill(' ');
+    return os;
+}
+
+/**
+ * Append a value to a string of bytes.
+ * \param [in,out] out The bytes.
+ * \param [in] value The value.
+ */
+template <typename V>
+void
+Put(std::string& out, V value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * Append a string, preceded by its size, to a string of bytes.
+ * \param [in,out] out The bytes.
+ * \param [in] s The string.
+ */
+void
+PutString(std::string& out, std::string_view s)
+{
+    Put<uint32_t>(out, s.size());
+    out.append(s);
+}
+
+LogBinarySink&
+LogBinarySink::Get()
+{
+    static LogBinarySink sink;
+    return sink;
+}
+
+LogBinarySink::~LogBinarySink()
+{
+    Disable();
+}
+
+void
+LogBinarySink::Enable(const std::string& filename)
+{
+    Disable();
+    std::unique_lock lock(m_mutex);
+    m_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        NS_FATAL_ERROR("Can't open the binary log file \"" << filename << "\"");
+    }
+    m_file.write(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+    // The call sites known from a previous file are written again
+    m_sitesWritten = 0;
+    m_stop = false;
+    m_thread = std::thread(&LogBinarySink::Run, this);
+    g_logBinaryEnabled = true;
+}
+
+void
+LogBinarySink::Disable()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    g_logBinaryEnabled = false;
+    {
+        std::unique_lock lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+    std::unique_lock lock(m_mutex);
+    DrainLocked();
+    m_file.close();
+}
+
+uint32_t
+LogBinarySink::RegisterSite(const std::string& component, const char* function, bool isFunction)
+{
+    std::unique_lock lock(m_mutex);
+    auto site = static_cast<uint32_t>(m_sites.size());
+    std::string record;
+    Put<uint32_t>(record, 0);
+    Put<uint8_t>(record, RECORD_SITE);
+    Put<uint32_t>(record, site);
+    Put<uint8_t>(record, isFunction);
+    PutString(record, component);
+    PutString(record, function);
+    auto size = static_cast<uint32_t>(record.size());
+    record.replace(0, sizeof(size), reinterpret_cast<const char*>(&size), sizeof(size));
+    m_sites.emplace_back(std::move(record));
+    return site;
+}
+
+LogBinaryThread&
+LogBinarySink::GetThread()
+{
+    if (t_logBinaryThread == nullptr)
+    {
+        std::unique_lock lock(m_mutex);
+        m_threads.emplace_back(std::make_unique<LogBinaryThread>());
+        t_logBinaryThread = m_threads.back().get();
+    }
+    return *t_logBinaryThread;
+}
+
+void
+LogBinarySink::Commit(const char* data, std::size_t size)
+{
+    if (size > LOG_BINARY_RING_SIZE / 2)
+    {
+        // Too large for the ring: write everything buffered, then the record
+        std::unique_lock lock(m_mutex);
+        DrainLocked();
+        m_file.write(data, size);
+        return;
+    }
+    LogBinaryThread& thread = GetThread();
+    uint64_t head = thread.head.load(std::memory_order_relaxed);
+    while (head + size - thread.tail.load(std::memory_order_acquire) > LOG_BINARY_RING_SIZE)
+    {
+        // The ring is full, wait for the drain thread
+        m_cv.notify_one();
+        std::this_thread::yield();
+    }
+    std::size_t offset = head % LOG_BINARY_RING_SIZE;
+    std::size_t first = std::min(size, LOG_BINARY_RING_SIZE - offset);
+    std::copy(data, data + first, thread.ring.get() + offset);
+    std::copy(data + first, data + size, thread.ring.get());
+    thread.head.store(head + size, std::memory_order_release);
+    if (head + size - thread.tail.load(std::memory_order_relaxed) > LOG_BINARY_RING_SIZE / 2)
+    {
+        m_cv.notify_one();
+    }
+}
+
+void
+LogBinarySink::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (!m_stop)
+    {
+        m_cv.wait_for(lock, LOG_BINARY_DRAIN_INTERVAL);
+        DrainLocked();
+    }
+}
+
+void
+LogBinarySink::DrainLocked()
+{
+    // The call sites of the records are registered before the records
+    // are committed, so they are written first
+    for (; m_sitesWritten < m_sites.size(); ++m_sitesWritten)
+    {
+        m_file.write(m_sites[m_sitesWritten].data(), m_sites[m_sitesWritten].size());
+    }
+    for (auto& thread : m_threads)
+    {
+        uint64_t head = thread->head.load(std::memory_order_acquire);
+        uint64_t tail = thread->tail.load(std::memory_order_relaxed);
+        if (head == tail)
+        {
+            continue;
+        }
+        std::size_t offset = tail % LOG_BINARY_RING_SIZE;
+        std::size_t size = head - tail;
+        std::size_t first = std::min(size, LOG_BINARY_RING_SIZE - offset);
+        m_file.write(thread->ring.get() + offset, first);
+        m_file.write(thread->ring.get(), size - first);
+        thread->tail.store(head, std::memory_order_release);
+    }
+}
+
+/**
+ * Enable the binary sink at startup if the \c binary-log option is
+ * present in NS_LOG.
+ */
+class LogBinaryEnvironment
+{
+  public:
+    LogBinaryEnvironment(); //!< Constructor, enables the binary sink.
+};
+
+LogBinaryEnvironment::LogBinaryEnvironment()
+{
+    auto [found, value] = EnvironmentVariable::Get("NS_LOG", "binary-log", ":");
+    if (found)
+    {
+        if (value.empty())
+        {
+            NS_FATAL_ERROR("Missing file name of the binary-log option in env variable NS_LOG");
+        }
+        LogBinaryEnable(value);
+    }
+}
+
+/** Invoke handler for \c binary-log in NS_LOG environment variable. */
+LogBinaryEnvironment g_logBinaryEnvironment;
+
+/**
+ * Reader of the binary records.
+ */
+class LogBinaryReader
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] data The payload of a record, after its size.
+     */
+    LogBinaryReader(std::string_view data)
+        : m_data(data)
+    {
+    }
+
+    /**
+     * Read a value.
+     * \param [out] value The value.
+     * \returns \c false if the record is truncated.
+     */
+    template <typename V>
+    bool Get(V& value)
+    {
+        if (m_data.size() < sizeof(V))
+        {
+            return false;
+        }
+        std::copy(m_data.begin(), m_data.begin() + sizeof(V), reinterpret_cast<char*>(&value));
+        m_data.remove_prefix(sizeof(V));
+        return true;
+    }
+
+    /**
+     * Read a string.
+     * \param [out] s The string.
+     * \returns \c false if the record is truncated.
+     */
+    bool GetString(std::string& s)
+    {
+        uint32_t size;
+        if (!Get(size) || m_data.size() < size)
+        {
+            return false;
+        }
+        s.assign(m_data.substr(0, size));
+        m_data.remove_prefix(size);
+        return true;
+    }
+
+    /**
+     * Check whether the whole record was read.
+     * \returns \c true if nothing is left to read.
+     */
+    bool AtEnd() const
+    {
+        return m_data.empty();
+    }
+
+  private:
+    std::string_view m_data; //!< The bytes left to read.
+};
+
+/** A call site read from a binary log file. */
+struct LogBinarySite
+{
+    bool isFunction;       //!< Whether the site is a NS_LOG_FUNCTION() one.
+    std::string component; //!< The component name.
+    std::string function;  //!< The function name.
+};
+
+/**
+ * Decode the values of a message record.
+ * \param [in] reader The reader, at the first value.
+ * \param [in] isFunction Whether the values are function parameters.
+ * \param [out] os The stream to write the values to.
+ * \returns \c false if the record is corrupted.
+ */
+bool
+DecodeValues(LogBinaryReader& reader, bool isFunction, std::ostream& os)
+{
+    std::ostringstream value;
+    bool first = true;
+    while (!reader.AtEnd())
+    {
+        value.str("");
+        value.flags(LOG_BINARY_DEFAULT_FLAGS);
+        uint8_t tag;
+        reader.Get(tag);
+        switch (tag)
+        {
+        case LogBinaryRecord::BOOL: {
+            uint8_t v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            if (isFunction)
+            {
+                value << +v;
+            }
+            else
+            {
+                value << static_cast<bool>(v);
+            }
+            break;
+        }
+        case LogBinaryRecord::CHAR: {
+            char v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            if (isFunction)
+            {
+                value << +v;
+            }
+            else
+            {
+                value << v;
+            }
+            break;
+        }
+        case LogBinaryRecord::SCHAR: {
+            signed char v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            if (isFunction)
+            {
+                value << +v;
+            }
+            else
+            {
+                value << v;
+            }
+            break;
+        }
+        case LogBinaryRecord::UCHAR: {
+            unsigned char v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            if (isFunction)
+            {
+                value << +v;
+            }
+            else
+            {
+                value << v;
+            }
+            break;
+        }
+        case LogBinaryRecord::INT: {
+            int64_t v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            value << v;
+            break;
+        }
+        case LogBinaryRecord::UINT: {
+            uint64_t v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            value << v;
+            break;
+        }
+        case LogBinaryRecord::DOUBLE: {
+            double v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            value << v;
+            break;
+        }
+        case LogBinaryRecord::POINTER: {
+            uint64_t v;
+            if (!reader.Get(v))
+            {
+                return false;
+            }
+            value << reinterpret_cast<const void*>(static_cast<uintptr_t>(v));
+            break;
+        }
+        case LogBinaryRecord::STRING:
+        case LogBinaryRecord::TEXT: {
+            std::string v;
+            if (!reader.GetString(v))
+            {
+                return false;
+            }
+            if (isFunction && tag == LogBinaryRecord::STRING)
+            {
+                value << "\"" << v << "\"";
+            }
+            else
+            {
+                value << v;
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+        if (isFunction && !first)
+        {
+            os << ", ";
+        }
+        first = false;
+        os << value.str();
+    }
+    return true;
+}
+
+/**
+ * Decode a time or node prefix.
+ * \param [in] reader The reader, at the prefix.
+ * \param [in] isTime Whether the prefix is the time.
+ * \param [out] os The stream to write the prefix to.
+ * \returns \c false if the record is corrupted.
+ */
+bool
+DecodePrefix(LogBinaryReader& reader, bool isTime, std::ostream& os)
+{
+    uint8_t format;
+    if (!reader.Get(format))
+    {
+        return false;
+    }
+    if (format == PREFIX_TEXT)
+    {
+        std::string text;
+        if (!reader.GetString(text))
+        {
+            return false;
+        }
+        os << text << " ";
+    }
+    else if (isTime)
+    {
+        uint8_t precision;
+        double seconds;
+        if (!reader.Get(precision) || !reader.Get(seconds))
+        {
+            return false;
+        }
+        std::ostringstream time;
+        time << std::fixed << std::setprecision(precision) << std::showpos << seconds << "s";
+        os << time.str() << " ";
+    }
+    else
+    {
+        uint32_t context;
+        if (!reader.Get(context))
+        {
+            return false;
+        }
+        if (context == Simulator::NO_CONTEXT)
+        {
+            os << "-1 ";
+        }
+        else
+        {
+            os << context << " ";
+        }
+    }
+    return true;
+}
+
+} // Unnamed namespace
+
+void
+LogBinaryEnable(const std::string& filename)
+{
+    LogBinarySink::Get().Enable(filename);
+}
+
+void
+LogBinaryDisable()
+{
+    LogBinarySink::Get().Disable();
+}
+
+bool
+LogBinaryIsEnabled()
+{
+    return g_logBinaryEnabled.load(std::memory_order_relaxed);
+}
+
+uint32_t
+LogBinaryRegisterSite(const LogComponent& component, const char* function, bool isFunction)
+{
+    return LogBinarySink::Get().RegisterSite(component.Name(), function, isFunction);
+}
+
+LogBinaryRecord::LogBinaryRecord(const LogComponent& component,
+                                 int32_t level,
+                                 uint32_t site,
+                                 bool isFunction)
+    : m_os(AcquireStream()),
+      m_start(t_logBinaryThread->buffer.size()),
+      m_isFunction(isFunction)
+{
+    std::string& out = t_logBinaryThread->buffer;
+    Put<uint32_t>(out, 0); // The size, set when the record is complete
+    Put<uint8_t>(out, RECORD_MESSAGE);
+    Put<uint32_t>(out, site);
+    Put<int32_t>(out, level);
+
+    TimePrinter timePrinter = LogGetTimePrinter();
+    NodePrinter nodePrinter = LogGetNodePrinter();
+    uint8_t prefixes = 0;
+    if (component.IsEnabled(LOG_PREFIX_TIME) && timePrinter != nullptr)
+    {
+        prefixes |= PREFIX_TIME;
+    }
+    if (component.IsEnabled(LOG_PREFIX_NODE) && nodePrinter != nullptr)
+    {
+        prefixes |= PREFIX_NODE;
+    }
+    if (!isFunction && component.IsEnabled(LOG_PREFIX_FUNC))
+    {
+        prefixes |= PREFIX_FUNC;
+    }
+    if (!isFunction && component.IsEnabled(LOG_PREFIX_LEVEL))
+    {
+        prefixes |= PREFIX_LEVEL;
+    }
+    Put<uint8_t>(out, prefixes);
+
+    if (prefixes & PREFIX_TIME)
+    {
+        if (timePrinter == &DefaultTimePrinter)
+        {
+            // Precision used by DefaultTimePrinter
+            uint8_t precision;
+            switch (Time::GetResolution())
+            {
+            case Time::US:
+                precision = 6;
+                break;
+            case Time::NS:
+                precision = 9;
+                break;
+            case Time::PS:
+                precision = 12;
+                break;
+            case Time::FS:
+                precision = 15;
+                break;
+            default:
+                precision = 5;
+            }
+            Put<uint8_t>(out, PREFIX_RAW);
+            Put<uint8_t>(out, precision);
+            Put<double>(out, Simulator::Now().ToDouble(Time::S));
+        }
+        else
+        {
+            (*timePrinter)(m_os);
+            Put<uint8_t>(out, PREFIX_TEXT);
+            PutString(out, m_os.str());
+            m_os.str("");
+        }
+    }
+    if (prefixes & PREFIX_NODE)
+    {
+        if (nodePrinter == &DefaultNodePrinter)
+        {
+            Put<uint8_t>(out, PREFIX_RAW);
+            Put<uint32_t>(out, Simulator::GetContext());
+        }
+        else
+        {
+            (*nodePrinter)(m_os);
+            Put<uint8_t>(out, PREFIX_TEXT);
+            PutString(out, m_os.str());
+            m_os.str("");
+        }
+    }
+}
+
+LogBinaryRecord::~LogBinaryRecord()
+{
+    std::string& out = t_logBinaryThread->buffer;
+    auto size = static_cast<uint32_t>(out.size() - m_start);
+    out.replace(m_start, sizeof(size), reinterpret_cast<const char*>(&size), sizeof(size));
+    if (g_logBinaryEnabled)
+    {
+        LogBinarySink::Get().Commit(out.data() + m_start, size);
+    }
+    out.resize(m_start);
+    --t_logBinaryThread->depth;
+}
+
+LogBinaryRecord&
+LogBinaryRecord::operator<<(std::ostream& (*manip)(std::ostream&))
+{
+    manip(m_os);
+    AppendText();
+    return *this;
+}
+
+LogBinaryRecord&
+LogBinaryRecord::operator<<(std::ios_base& (*manip)(std::ios_base&))
+{
+    manip(m_os);
+    AppendText();
+    return *this;
+}
+
+bool
+LogBinaryRecord::IsDefaultFormat() const
+{
+    return m_os.flags() == LOG_BINARY_DEFAULT_FLAGS && m_os.precision() == 6 &&
+           m_os.width() == 0 && m_os.fill() == ' ';
+}
+
+void
+LogBinaryRecord::Append(const void* data, std::size_t size)
+{
+    t_logBinaryThread->buffer.append(static_cast<const char*>(data), size);
+}
+
+void
+LogBinaryRecord::AppendString(Tag tag, std::string_view s)
+{
+    std::string& out = t_logBinaryThread->buffer;
+    Put<uint8_t>(out, tag);
+    PutString(out, s);
+}
+
+void
+LogBinaryRecord::AppendText()
+{
+    // Avoid copying the text out of the stream when there's none
+    if (m_isFunction || m_os.tellp() > 0)
+    {
+        AppendString(TEXT, m_os.str());
+        m_os.str("");
+    }
+}
+
+bool
+LogBinaryDecode(std::istream& is, std::ostream& os)
+{
+    char magic[sizeof(LOG_BINARY_MAGIC)];
+    if (!is.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), LOG_BINARY_MAGIC))
+    {
+        return false;
+    }
+
+    std::map<uint32_t, LogBinarySite> sites;
+    std::string data;
+    uint32_t size;
+    while (is.read(reinterpret_cast<char*>(&size), sizeof(size)))
+    {
+        if (size <= sizeof(size))
+        {
+            return false;
+        }
+        data.resize(size - sizeof(size));
+        if (!is.read(data.data(), data.size()))
+        {
+            return false;
+        }
+        LogBinaryReader reader(data);
+        uint8_t kind;
+        reader.Get(kind);
+        if (kind == RECORD_SITE)
+        {
+            uint32_t id;
+            uint8_t isFunction;
+            LogBinarySite site;
+            if (!reader.Get(id) || !reader.Get(isFunction) || !reader.GetString(site.component) ||
+                !reader.GetString(site.function))
+            {
+                return false;
+            }
+            site.isFunction = isFunction;
+            sites[id] = site;
+            continue;
+        }
+        if (kind != RECORD_MESSAGE)
+        {
+            return false;
+        }
+
+        uint32_t id;
+        int32_t level;
+        uint8_t prefixes;
+        if (!reader.Get(id) || !reader.Get(level) || !reader.Get(prefixes))
+        {
+            return false;
+        }
+        auto it = sites.find(id);
+        if (it == sites.end())
+        {
+            return false;
+        }
+        const LogBinarySite& site = it->second;
+        if (((prefixes & PREFIX_TIME) && !DecodePrefix(reader, true, os)) ||
+            ((prefixes & PREFIX_NODE) && !DecodePrefix(reader, false, os)))
+        {
+            return false;
+        }
+        if (site.isFunction)
+        {
+            os << site.component << ":" << site.function << "(";
+        }
+        else
+        {
+            if (prefixes & PREFIX_FUNC)
+            {
+                os << site.component << ":" << site.function << "(): ";
+            }
+            if (prefixes & PREFIX_LEVEL)
+            {
+                os << "[" << LogComponent::GetLevelLabel(static_cast<LogLevel>(level)) << "] ";
+            }
+        }
+        if (!DecodeValues(reader, site.isFunction, os))
+        {
+            return false;
+        }
+        if (site.isFunction)
+        {
+            os << ")";
+        }
+        os << std::endl;
+    }
+    return is.eof();
+}
+
+} // namespace ns3
@@ -0,0 +1,422 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_BINARY_H
+#define NS3_LOG_BINARY_H
+
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary sink of the log messages.
+ */
+
+namespace ns3
+{
+
+class LogComponent;
+
+/**
+ * \ingroup logging
+ * \defgroup logbinary Binary logging
+ *
+ * Instead of formatting the log messages on \c std::clog, the NS_LOG
+ * macros can write compact binary records to a file: the simulation
+ * time, the context, the call site (which identifies the component,
+ * the function and the kind of message) and the raw values of the
+ * arguments.  Records are buffered per thread in lock-free rings, and
+ * a background thread writes them to the file.  The file is turned
+ * into the usual text output by LogBinaryDecode(), which is what the
+ * \c decode-binary-log program does.
+ *
+ * The binary sink is enabled with the \c binary-log option of the
+ * \c NS_LOG environment variable, which gives the file name:
+ * \code
+ *   $ NS_LOG='*=level_all|prefix_all:binary-log=run.nslog' ./ns3 run ...
+ *   $ ./build/utils/ns3-dev-decode-binary-log-debug run.nslog
+ * \endcode
+ * or with LogBinaryEnable().
+ *
+ * Values of arithmetic, pointer and string types are stored as they
+ * are.  Other values, and values streamed after a manipulator changed
+ * the format of the stream, are formatted to text when logged.  The
+ * time and node prefixes are written as the default TimePrinter and
+ * NodePrinter would, and the NS_LOG_APPEND_CONTEXT prefixes are not
+ * written.  NS_LOG_UNCOND messages are always written on \c std::clog.
+ *
+ * Records use the byte order of the machine writing them.
+ */
+
+/**
+ * \ingroup logbinary
+ * Write the log messages to a binary file, until LogBinaryDisable().
+ *
+ * \param [in] filename The name of the file.
+ */
+void LogBinaryEnable(const std::string& filename);
+
+/**
+ * \ingroup logbinary
+ * Write the buffered records, close the binary file and log on
+ * \c std::clog again.
+ *
+ * No other thread should be logging when this is called.
+ */
+void LogBinaryDisable();
+
+/**
+ * \ingroup logbinary
+ * Check whether the log messages are written to a binary file.
+ *
+ * \returns \c true if the binary sink is enabled.
+ */
+bool LogBinaryIsEnabled();
+
+/**
+ * \ingroup logbinary
+ * Register a log call site with the binary sink.
+ *
+ * \internal
+ * Called once per call site by the NS_LOG macros.
+ *
+ * \param [in] component The LogComponent of the call site.
+ * \param [in] function The name of the function containing the call site.
+ * \param [in] isFunction \c true for NS_LOG_FUNCTION() call sites.
+ * \returns The identifier of the call site.
+ */
+uint32_t LogBinaryRegisterSite(const LogComponent& component,
+                               const char* function,
+                               bool isFunction);
+
+/**
+ * \ingroup logbinary
+ * Decode a binary log file into the text output of the log messages.
+ *
+ * \param [in] is The stream to read the binary records from.
+ * \param [in] os The stream to write the messages to.
+ * \returns \c false if the file is not a binary log, or is truncated.
+ */
+bool LogBinaryDecode(std::istream& is, std::ostream& os);
+
+/**
+ * \ingroup logbinary
+ * Build the binary record of a log message.
+ *
+ * The message is streamed into this object like it is into \c std::clog,
+ * and the record is written to the binary sink when this object goes
+ * out of scope.
+ *
+ * \internal
+ * Records are built in a per-thread buffer, so that building one does
+ * not allocate.
+ */
+class LogBinaryRecord
+{
+  public:
+    /** Type tags of the values of a record. */
+    enum Tag : uint8_t
+    {
+        BOOL = 1, //!< bool, 1 byte.
+        CHAR,     //!< char, 1 byte.
+        SCHAR,    //!< signed char, 1 byte.
+        UCHAR,    //!< unsigned char, 1 byte.
+        INT,      //!< Signed integer, 8 bytes.
+        UINT,     //!< Unsigned integer, 8 bytes.
+        DOUBLE,   //!< float or double, 8 bytes.
+        POINTER,  //!< Address, 8 bytes.
+        STRING,   //!< String, 4 bytes size and the characters.
+        TEXT      //!< Formatted value, 4 bytes size and the characters.
+    };
+
+    /**
+     * Start a record.
+     *
+     * \param [in] component The LogComponent of the message.
+     * \param [in] level The level of the message.
+     * \param [in] site The call site, from LogBinaryRegisterSite().
+     * \param [in] isFunction \c true for the parameters of NS_LOG_FUNCTION().
+     */
+    LogBinaryRecord(const LogComponent& component, int32_t level, uint32_t site, bool isFunction);
+    /** Write the record to the binary sink. */
+    ~LogBinaryRecord();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogBinaryRecord(const LogBinaryRecord&) = delete;
+    LogBinaryRecord& operator=(const LogBinaryRecord&) = delete;
+
+    /**
+     * Add a value to the record.
+     *
+     * The value is forwarded, since some types are only printable
+     * as non-const references.
+     *
+     * \tparam T \deduced The type of the value.
+     * \param [in] value The value.
+     * \returns This record, so it's chainable.
+     */
+    template <typename T>
+    LogBinaryRecord& operator<<(T&& value);
+
+    /**
+     * Apply a manipulator, such as \c std::endl.
+     *
+     * \param [in] manip The manipulator.
+     * \returns This record, so it's chainable.
+     */
+    LogBinaryRecord& operator<<(std::ostream& (*manip)(std::ostream&));
+
+    /**
+     * Apply a manipulator, such as \c std::hex.
+     *
+     * \param [in] manip The manipulator.
+     * \returns This record, so it's chainable.
+     */
+    LogBinaryRecord& operator<<(std::ios_base& (*manip)(std::ios_base&));
+
+  private:
+    /**
+     * Check whether values can be stored raw, i.e., no manipulator
+     * changed the format of the stream.
+     *
+     * \returns \c true if the stream has its default format.
+     */
+    bool IsDefaultFormat() const;
+    /**
+     * Append bytes to the record.
+     *
+     * \param [in] data The bytes.
+     * \param [in] size The number of bytes.
+     */
+    void Append(const void* data, std::size_t size);
+    /**
+     * Append a tagged value to the record.
+     *
+     * \tparam V \deduced The type of the value.
+     * \param [in] tag The tag.
+     * \param [in] value The value.
+     */
+    template <typename V>
+    void AppendValue(Tag tag, V value)
+    {
+        Append(&tag, 1);
+        Append(&value, sizeof(value));
+    }
+
+    /**
+     * Append a string to the record.
+     *
+     * \param [in] tag STRING or TEXT.
+     * \param [in] s The string.
+     */
+    void AppendString(Tag tag, std::string_view s);
+    /**
+     * Append the text formatted on the stream to the record.
+     *
+     * In messages the text is skipped if empty, in the parameters of
+     * a function it's a parameter even if empty.
+     */
+    void AppendText();
+    /**
+     * Add a vector to the record: each element is a parameter of
+     * a function, like with ParameterLogger.
+     *
+     * \tparam T \deduced The type of the elements.
+     * \param [in] vector The vector.
+     */
+    template <typename T>
+    void AppendVector(const std::vector<T>& vector);
+    /**
+     * Format a value on the stream like the text sink does, and
+     * append it to the record.
+     *
+     * \tparam T \deduced The type of the value.
+     * \param [in] value The value.
+     */
+    template <typename T>
+    void AppendFormatted(T&& value);
+
+    std::ostringstream& m_os; //!< The stream formatting the non raw values.
+    std::size_t m_start;      //!< Offset of the record in the per-thread buffer.
+    bool m_isFunction;        //!< Whether the values are function parameters.
+};
+
+/**
+ * \ingroup logbinary
+ * Pointers logged as their address, i.e., object pointers which
+ * have no operator<< of their own.
+ *
+ * \tparam T The type of the pointer.
+ */
+template <typename T>
+concept LogBinaryRawPointer =
+    std::is_pointer_v<T> && std::is_object_v<std::remove_pointer_t<T>> &&
+    !requires(std::ostream& os, const T& p) { operator<<(os, p); };
+
+/**
+ * \ingroup logbinary
+ * Smart pointers logged as their address, i.e., Ptr to types which
+ * are LogBinaryRawPointer.
+ *
+ * \tparam T The type of the smart pointer.
+ */
+template <typename T>
+concept LogBinaryRawSmartPointer = requires(const T& p) { PeekPointer(p); } &&
+                                   LogBinaryRawPointer<decltype(PeekPointer(std::declval<T>()))>;
+
+/**
+ * \ingroup logbinary
+ * Vectors, whose elements are separate parameters of a function.
+ *
+ * \tparam T The type of the vector.
+ */
+template <typename T>
+concept LogBinaryVector = requires { typename T::value_type; } &&
+                          std::is_same_v<T, std::vector<typename T::value_type>>;
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+LogBinaryRecord&
+LogBinaryRecord::operator<<(T&& value)
+{
+    using U = std::remove_cvref_t<T>;
+    if constexpr (LogBinaryVector<U>)
+    {
+        AppendVector(value);
+    }
+    else if (!IsDefaultFormat())
+    {
+        AppendFormatted(std::forward<T>(value));
+    }
+    else if constexpr (std::is_same_v<U, bool>)
+    {
+        AppendValue<uint8_t>(BOOL, value);
+    }
+    else if constexpr (std::is_same_v<U, char>)
+    {
+        AppendValue(CHAR, value);
+    }
+    else if constexpr (std::is_same_v<U, signed char>)
+    {
+        AppendValue(SCHAR, value);
+    }
+    else if constexpr (std::is_same_v<U, unsigned char>)
+    {
+        AppendValue(UCHAR, value);
+    }
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+    {
+        AppendValue<int64_t>(INT, value);
+    }
+    else if constexpr (std::is_integral_v<U>)
+    {
+        AppendValue<uint64_t>(UINT, value);
+    }
+    else if constexpr (std::is_same_v<U, float> || std::is_same_v<U, double>)
+    {
+        AppendValue<double>(DOUBLE, value);
+    }
+    else if constexpr (std::is_same_v<U, std::string> ||
+                       (std::is_array_v<U> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<U>>, char>))
+    {
+        AppendString(STRING, value);
+    }
+    else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>)
+    {
+        if (value != nullptr)
+        {
+            AppendString(STRING, value);
+        }
+        else
+        {
+            AppendFormatted(std::forward<T>(value));
+        }
+    }
+    else if constexpr (LogBinaryRawPointer<U>)
+    {
+        AppendValue<uint64_t>(POINTER, reinterpret_cast<uintptr_t>(value));
+    }
+    else if constexpr (LogBinaryRawSmartPointer<U>)
+    {
+        // Ptr<T> prints its pointer
+        AppendValue<uint64_t>(POINTER, reinterpret_cast<uintptr_t>(PeekPointer(value)));
+    }
+    else
+    {
+        AppendFormatted(std::forward<T>(value));
+    }
+    return *this;
+}
+
+template <typename T>
+void
+LogBinaryRecord::AppendVector(const std::vector<T>& vector)
+{
+    if (m_isFunction)
+    {
+        // Each element is a parameter, like with ParameterLogger
+        for (const auto& i : vector)
+        {
+            *this << i;
+        }
+    }
+    else if constexpr (requires(std::ostream& os) { os << vector; })
+    {
+        AppendFormatted(vector);
+    }
+}
+
+template <typename T>
+void
+LogBinaryRecord::AppendFormatted(T&& value)
+{
+    using U = std::remove_cvref_t<T>;
+    if (!m_isFunction)
+    {
+        m_os << value;
+    }
+    else if constexpr (std::is_convertible_v<U, std::string>)
+    {
+        m_os << "\"" << value << "\"";
+    }
+    else if constexpr (std::is_arithmetic_v<U>)
+    {
+        m_os << +value;
+    }
+    else
+    {
+        m_os << value;
+    }
+    AppendText();
+}
+
+} // namespace ns3
+
+#endif /* NS3_LOG_BINARY_H */
@@ -120,6 +120,19 @@
         std::clog << "[" << g_log.GetLevelLabel(level) << "] ";                                    \
     }
 
+/**
+ * \ingroup logging
+ * Register the call site of a log message with the binary sink,
+ * once, as \c nsLogSite.
+ * \internal
+ * Logging implementation macro; should not be called directly.
+ *
+ * \param [in] isFunction \c true for the NS_LOG_FUNCTION() call sites.
+ */
+#define NS_LOG_BINARY_SITE(isFunction)                                                             \
+    static const uint32_t nsLogSite =                                                              \
+        ns3::LogBinaryRegisterSite(g_log, __FUNCTION__, isFunction)
+
 #ifndef NS_LOG_APPEND_CONTEXT
 /**
  * \ingroup logging
@@ -184,14 +197,22 @@
     {                                                                                              \
         if (g_log.IsEnabled(level))                                                                \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            NS_LOG_APPEND_FUNC_PREFIX;                                                             \
-            NS_LOG_APPEND_LEVEL_PREFIX(level);                                                     \
-            auto flags = std::clog.setf(std::ios_base::boolalpha);                                 \
-            std::clog << msg << std::endl;                                                         \
-            std::clog.flags(flags);                                                                \
+            if (ns3::LogBinaryIsEnabled())                                                         \
+            {                                                                                      \
+                NS_LOG_BINARY_SITE(false);                                                         \
+                ns3::LogBinaryRecord(g_log, level, nsLogSite, false) << msg;                       \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                NS_LOG_APPEND_FUNC_PREFIX;                                                         \
+                NS_LOG_APPEND_LEVEL_PREFIX(level);                                                 \
+                auto flags = std::clog.setf(std::ios_base::boolalpha);                             \
+                std::clog << msg << std::endl;                                                     \
+                std::clog.flags(flags);                                                            \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
@@ -209,10 +230,18 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            std::clog << g_log.Name() << ":" << __FUNCTION__ << "()" << std::endl;                 \
+            if (ns3::LogBinaryIsEnabled())                                                         \
+            {                                                                                      \
+                NS_LOG_BINARY_SITE(true);                                                          \
+                ns3::LogBinaryRecord(g_log, ns3::LOG_FUNCTION, nsLogSite, true);                   \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                std::clog << g_log.Name() << ":" << __FUNCTION__ << "()" << std::endl;             \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
@@ -243,14 +272,22 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            std::clog << g_log.Name() << ":" << __FUNCTION__ << "(";                               \
-            auto flags = std::clog.setf(std::ios_base::boolalpha);                                 \
-            ns3::ParameterLogger(std::clog) << parameters;                                         \
-            std::clog.flags(flags);                                                                \
-            std::clog << ")" << std::endl;                                                         \
+            if (ns3::LogBinaryIsEnabled())                                                         \
+            {                                                                                      \
+                NS_LOG_BINARY_SITE(true);                                                          \
+                ns3::LogBinaryRecord(g_log, ns3::LOG_FUNCTION, nsLogSite, true) << parameters;     \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                std::clog << g_log.Name() << ":" << __FUNCTION__ << "(";                           \
+                auto flags = std::clog.setf(std::ios_base::boolalpha);                             \
+                ns3::ParameterLogger(std::clog) << parameters;                                     \
+                std::clog.flags(flags);                                                            \
+                std::clog << ")" << std::endl;                                                     \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
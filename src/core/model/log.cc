@@ -454,6 +454,11 @@ CheckEnvironmentVariables()
 
     for (auto& [component, value] : dict)
     {
+        if (component == "binary-log")
+        {
+            // The file name of the binary sink, see log-binary.cc
+            continue;
+        }
         if (component != "*" && component != "***" && !ComponentExists(component))
         {
             NS_LOG_UNCOND("Invalid or unregistered component name \"" << component << "\"");
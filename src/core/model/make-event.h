@@ -21,7 +21,10 @@
 
 #include "warnings.h"
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 
@@ -137,6 +140,96 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * \ingroup events
+ * Helper for GetMemberFunctionAddress(), giving the class of a member
+ * pointer.
+ *
+ * This is the generic template declaration (with empty body).
+ *
+ * \tparam T \explicit The member pointer type.
+ */
+template <typename T>
+struct MemberPointerClass;
+
+/**
+ * \ingroup events
+ * Helper for GetMemberFunctionAddress(), giving the class of a member
+ * pointer.
+ *
+ * This is the specialization for member pointers.
+ *
+ * \tparam F \explicit The member type.
+ * \tparam C \explicit The class type.
+ */
+template <typename F, typename C>
+struct MemberPointerClass<F C::*>
+{
+    typedef C Type; //!< The class type.
+};
+
+/**
+ * \ingroup events
+ * Get the address of the code called through a member function pointer.
+ *
+ * This decodes the member function pointers of the Itanium C++ ABI
+ * used by GCC and Clang.  A virtual function is looked up in the
+ * vtable of the object.
+ *
+ * \tparam MEM \deduced The member pointer type.
+ * \tparam OBJ \deduced The object type: a pointer, a smart pointer or
+ *         a class instance.
+ * \param [in] function The member function pointer.
+ * \param [in] obj The object the function is called on.
+ * \returns The function address, or \c nullptr if unknown.
+ */
+template <typename MEM, typename OBJ>
+const void*
+GetMemberFunctionAddress(MEM function, const OBJ& obj)
+{
+#if defined(__GNUC__)
+    if constexpr (std::is_member_function_pointer_v<MEM> &&
+                  sizeof(MEM) == sizeof(std::uintptr_t) + sizeof(std::ptrdiff_t))
+    {
+        struct
+        {
+            std::uintptr_t ptr;
+            std::ptrdiff_t adj;
+        } pmf;
+
+        std::memcpy(&pmf, &function, sizeof(pmf));
+#if defined(__arm__) || defined(__aarch64__)
+        // The ARM variant of the ABI flags the virtual functions in adj
+        const bool isVirtual = pmf.adj & 1;
+        const std::ptrdiff_t adj = pmf.adj >> 1;
+        const std::uintptr_t offset = pmf.ptr;
+#else
+        const bool isVirtual = pmf.ptr & 1;
+        const std::ptrdiff_t adj = pmf.adj;
+        const std::uintptr_t offset = pmf.ptr - 1;
+#endif
+        if (!isVirtual)
+        {
+            return reinterpret_cast<const void*>(pmf.ptr);
+        }
+        typedef typename MemberPointerClass<MEM>::Type Class;
+        const Class* object;
+        if constexpr (requires { *obj; })
+        {
+            object = std::addressof(*obj);
+        }
+        else
+        {
+            object = std::addressof(obj);
+        }
+        const char* self = reinterpret_cast<const char*>(object) + adj;
+        const char* vtable = *reinterpret_cast<const char* const*>(self);
+        return *reinterpret_cast<const void* const*>(vtable + offset);
+    }
+#endif
+    return nullptr;
+}
+
 } // namespace internal
 
 template <typename MEM, typename OBJ, typename... Ts>
@@ -149,8 +242,15 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_obj(obj),
+              m_function(function),
+              m_arguments(args...)
+        {
+        }
+
+        const void* GetFunction() const override
         {
+            return internal::GetMemberFunctionAddress(m_function, m_obj);
         }
 
       protected:
@@ -161,10 +261,13 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](Ts... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
         }
 
-        std::function<void()> m_function;
+        OBJ m_obj;
+        MEM m_function;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -183,6 +286,11 @@ MakeEvent(void (*f)(Us...), Ts... args)
         {
         }
 
+        const void* GetFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
       protected:
         ~EventFunctionImpl() override
         {
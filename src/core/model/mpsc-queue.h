@@ -0,0 +1,263 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MpscQueue template declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ * \brief A multiple producer, single consumer queue.
+ *
+ * Items are pushed by any thread and popped by a single consumer thread,
+ * typically the simulator main thread.  The queue is a bounded ring of
+ * cells, each tagged with a sequence number, so that producers only
+ * contend on an atomic increment, and the consumer never takes a lock.
+ * An atomic flag tells the consumer whether anything was pushed since it
+ * last drained the queue, making the common empty case a single load.
+ *
+ * When the ring is full, items spill into an overflow list protected by
+ * a mutex, so that Push() never blocks on the consumer.  The overflow
+ * list is only drained once every claimed cell of the ring has been
+ * popped, so items pushed by one producer are always popped in order.
+ *
+ * \tparam T \explicit The item type, which must be copyable.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] capacity The size of the ring, rounded up to a power of two.
+     */
+    explicit MpscQueue(std::size_t capacity = 1024);
+
+    /**
+     * Add an item to the queue.  Safe to call from any thread.
+     *
+     * \param [in] item The item.
+     */
+    void Push(const T& item);
+
+    /**
+     * Check whether items were pushed since the last PopAll().
+     *
+     * This is a hint for the consumer: an item may be completely
+     * pushed right after this returns \c true.
+     *
+     * \returns \c true if there is nothing to pop.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Pop all the pending items.  Must be called from the consumer thread.
+     *
+     * \tparam F \deduced The consumer function type.
+     * \param [in] consume A function called with each item, in order.
+     */
+    template <typename F>
+    void PopAll(F consume);
+
+  private:
+    /** One cell of the ring. */
+    struct Cell
+    {
+        /**
+         * Sequence number: the ring position when the cell is free,
+         * one more when it holds an item.
+         */
+        std::atomic<std::size_t> sequence;
+        T item; /**< The item. */
+    };
+
+    /**
+     * Push an item into the ring.
+     *
+     * \param [in] item The item.
+     * \returns \c false if the ring is full.
+     */
+    bool TryPush(const T& item);
+    /**
+     * Pop an item from the ring.
+     *
+     * \param [out] item The item.
+     * \returns \c false if the ring is empty.
+     */
+    bool TryPop(T& item);
+
+    std::unique_ptr<Cell[]> m_cells; /**< The ring. */
+    std::size_t m_mask;              /**< Ring size minus one. */
+    std::size_t m_head;              /**< Next position to pop, owned by the consumer. */
+
+    alignas(64) std::atomic<std::size_t> m_tail; /**< Next position to push. */
+    alignas(64) std::atomic<bool> m_empty;       /**< Nothing pushed since the last PopAll(). */
+
+    std::atomic<bool> m_overflowing; /**< Whether m_overflow holds items. */
+    std::mutex m_overflowMutex;      /**< Protects m_overflow. */
+    std::vector<T> m_overflow;       /**< Items which did not fit in the ring. */
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity)
+    : m_head(0),
+      m_tail(0),
+      m_empty(true),
+      m_overflowing(false)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+    m_cells = std::make_unique<Cell[]>(size);
+    m_mask = size - 1;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::TryPush(const T& item)
+{
+    std::size_t pos = m_tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;)
+    {
+        cell = &m_cells[pos & m_mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+        if (diff == 0)
+        {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The consumer has not released this cell yet
+            return false;
+        }
+        else
+        {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+    cell->item = item;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::TryPop(T& item)
+{
+    Cell* cell = &m_cells[m_head & m_mask];
+    if (cell->sequence.load(std::memory_order_acquire) != m_head + 1)
+    {
+        return false;
+    }
+    item = cell->item;
+    cell->sequence.store(m_head + m_mask + 1, std::memory_order_release);
+    m_head++;
+    return true;
+}
+
+template <typename T>
+void
+MpscQueue<T>::Push(const T& item)
+{
+    if (m_overflowing.load(std::memory_order_acquire) || !TryPush(item))
+    {
+        std::unique_lock lock{m_overflowMutex};
+        m_overflow.push_back(item);
+        m_overflowing.store(true, std::memory_order_release);
+    }
+    m_empty.store(false, std::memory_order_release);
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty() const
+{
+    return m_empty.load(std::memory_order_acquire);
+}
+
+template <typename T>
+template <typename F>
+void
+MpscQueue<T>::PopAll(F consume)
+{
+    // Clear the flag first: an item pushed from now on sets it again.
+    m_empty.exchange(true, std::memory_order_acq_rel);
+
+    T item;
+    while (TryPop(item))
+    {
+        consume(item);
+    }
+    if (m_overflowing.load(std::memory_order_acquire))
+    {
+        if (m_head != m_tail.load(std::memory_order_acquire))
+        {
+            // A producer has claimed a cell but not written it yet.  The
+            // spilled items may have been pushed after it by the same
+            // thread, so leave them for the next call.
+            m_empty.store(false, std::memory_order_release);
+            return;
+        }
+        std::vector<T> overflow;
+        {
+            std::unique_lock lock{m_overflowMutex};
+            overflow.swap(m_overflow);
+            m_overflowing.store(false, std::memory_order_release);
+        }
+        for (const auto& spilled : overflow)
+        {
+            consume(spilled);
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
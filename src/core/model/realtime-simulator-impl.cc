@@ -30,6 +30,7 @@
 #include "synchronizer.h"
 #include "wall-clock-synchronizer.h"
 
+#include <algorithm>
 #include <cmath>
 #include <mutex>
 #include <thread>
@@ -103,6 +104,7 @@ void
 RealtimeSimulatorImpl::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
     while (!m_events->IsEmpty())
     {
         Scheduler::Event next = m_events->RemoveNext();
@@ -218,6 +220,15 @@ RealtimeSimulatorImpl::ProcessOneEvent()
                 m_synchronizer->Realtime(),
                 "RealtimeSimulatorImpl::ProcessOneEvent (): Synchronizer reports not Realtime ()");
 
+            //
+            // Reset the synchronizer so that any future event will cause it to
+            // interrupt, before looking for events queued by other threads:
+            // those threads signal the synchronizer after queueing an event,
+            // so an event we miss here will interrupt the wait below.
+            //
+            m_synchronizer->SetCondition(false);
+            ProcessEventsWithContext();
+
             //
             // tsNow is set to the normalized current real time.  When the simulation was
             // started, the current real time was effectively set to zero; so tsNow is
@@ -250,10 +261,9 @@ RealtimeSimulatorImpl::ProcessOneEvent()
             // We've figured out how long we need to delay in order to pace the
             // simulation time with the real time.  We're going to sleep, but need
             // to work with the synchronizer to make sure we're awakened if something
-            // external happens (like a packet is received).  This next line resets
-            // the synchronizer so that any future event will cause it to interrupt.
+            // external happens (like a packet is received).  The synchronizer was
+            // reset above so that any future event will cause it to interrupt.
             //
-            m_synchronizer->SetCondition(false);
         }
 
         //
@@ -321,8 +331,10 @@ RealtimeSimulatorImpl::ProcessOneEvent()
         // We do know we're waiting for an event, so there had better be an event on the
         // event queue.  Let's pull it off.  When we release the critical section, the
         // event we're working on won't be on the list and so subsequent operations won't
-        // mess with us.
+        // mess with us.  Events queued by other threads in the meantime may
+        // be due before it.
         //
+        ProcessEventsWithContext();
         NS_ASSERT_MSG(m_events->IsEmpty() == false,
                       "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
         next = m_events->RemoveNext();
@@ -401,7 +413,7 @@ RealtimeSimulatorImpl::IsFinished() const
     bool rc;
     {
         std::unique_lock lock{m_mutex};
-        rc = m_events->IsEmpty() || m_stop;
+        rc = (m_events->IsEmpty() && m_eventsWithContext.IsEmpty()) || m_stop;
     }
 
     return rc;
@@ -419,6 +431,47 @@ RealtimeSimulatorImpl::NextTs() const
     return ev.key.m_ts;
 }
 
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext()
+{
+    if (m_eventsWithContext.IsEmpty())
+    {
+        return;
+    }
+
+    m_eventsWithContext.PopAll([this](const EventWithContext& event) {
+        //
+        // The main thread may have run events due after the timestamp, since
+        // it was computed by the other thread: run it as soon as possible.
+        //
+        Scheduler::Event ev;
+        ev.impl = event.event;
+        ev.key.m_ts = event.relative ? m_currentTs + event.timestamp
+                                     : std::max(event.timestamp, m_currentTs);
+        ev.key.m_context = event.context;
+        ev.key.m_uid = m_uid;
+        m_uid++;
+        m_unscheduledEvents++;
+        m_events->Insert(ev);
+    });
+}
+
+void
+RealtimeSimulatorImpl::QueueEventWithContext(uint32_t context,
+                                             uint64_t ts,
+                                             bool relative,
+                                             EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << ts << relative << event);
+    EventWithContext ev;
+    ev.context = context;
+    ev.relative = relative;
+    ev.timestamp = ts;
+    ev.event = event;
+    m_eventsWithContext.Push(ev);
+    m_synchronizer->Signal();
+}
+
 void
 RealtimeSimulatorImpl::Run()
 {
@@ -443,6 +496,7 @@ RealtimeSimulatorImpl::Run()
         {
             std::unique_lock lock{m_mutex};
 
+            ProcessEventsWithContext();
             if (!m_events->IsEmpty())
             {
                 process = true;
@@ -542,23 +596,29 @@ RealtimeSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay,
 {
     NS_LOG_FUNCTION(this << context << delay << impl);
 
+    if (m_main != std::this_thread::get_id())
     {
-        std::unique_lock lock{m_mutex};
-        uint64_t ts;
-
-        if (m_main == std::this_thread::get_id())
+        //
+        // If the simulator is running, we're pacing and have a meaningful
+        // realtime clock.  If we're not, then m_currentTs is where we stopped.
+        //
+        if (m_running)
         {
-            ts = m_currentTs + delay.GetTimeStep();
+            QueueEventWithContext(context,
+                                  m_synchronizer->GetCurrentRealtime() + delay.GetTimeStep(),
+                                  false,
+                                  impl);
         }
         else
         {
-            //
-            // If the simulator is running, we're pacing and have a meaningful
-            // realtime clock.  If we're not, then m_currentTs is where we stopped.
-            //
-            ts = m_running ? m_synchronizer->GetCurrentRealtime() : m_currentTs;
-            ts += delay.GetTimeStep();
+            QueueEventWithContext(context, delay.GetTimeStep(), true, impl);
         }
+        return;
+    }
+
+    {
+        std::unique_lock lock{m_mutex};
+        uint64_t ts = m_currentTs + delay.GetTimeStep();
 
         NS_ASSERT_MSG(ts >= m_currentTs,
                       "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
@@ -597,6 +657,15 @@ RealtimeSimulatorImpl::ScheduleRealtimeWithContext(uint32_t context,
 {
     NS_LOG_FUNCTION(this << context << time << impl);
 
+    if (m_main != std::this_thread::get_id())
+    {
+        QueueEventWithContext(context,
+                              m_synchronizer->GetCurrentRealtime() + time.GetTimeStep(),
+                              false,
+                              impl);
+        return;
+    }
+
     {
         std::unique_lock lock{m_mutex};
 
@@ -625,6 +694,20 @@ void
 RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext(uint32_t context, EventImpl* impl)
 {
     NS_LOG_FUNCTION(this << context << impl);
+
+    if (m_main != std::this_thread::get_id())
+    {
+        if (m_running)
+        {
+            QueueEventWithContext(context, m_synchronizer->GetCurrentRealtime(), false, impl);
+        }
+        else
+        {
+            QueueEventWithContext(context, 0, true, impl);
+        }
+        return;
+    }
+
     {
         std::unique_lock lock{m_mutex};
 
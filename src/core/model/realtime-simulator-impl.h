@@ -21,6 +21,7 @@
 #include "assert.h"
 #include "event-impl.h"
 #include "log.h"
+#include "mpsc-queue.h"
 #include "ptr.h"
 #include "scheduler.h"
 #include "simulator-impl.h"
@@ -181,9 +182,43 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint64_t NextTs() const;
     /** Process the next event. */
     void ProcessOneEvent();
+    /**
+     * Move events scheduled from other threads into the event list.
+     * Called from the main thread, with #m_mutex held.
+     */
+    void ProcessEventsWithContext();
+    /**
+     * Queue an event scheduled from another thread than the main one.
+     *
+     * \param [in] context The event context.
+     * \param [in] ts The event timestamp.
+     * \param [in] relative Whether \p ts is relative to the current time
+     *              when the event is moved to the event list.
+     * \param [in] event The event.
+     */
+    void QueueEventWithContext(uint32_t context, uint64_t ts, bool relative, EventImpl* event);
     /** Destructor implementation. */
     void DoDispose() override;
 
+    /** Wrap an event scheduled from another thread with its execution context. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Whether the timestamp is relative to the current time. */
+        bool relative;
+        /** Event timestamp. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /**
+     * The events scheduled from other threads, waiting to be moved to
+     * the event list by the main thread.
+     */
+    MpscQueue<EventWithContext> m_eventsWithContext;
+
     /** Container type for events to be run at destroy time. */
     typedef std::list<EventId> DestroyEvents;
     /** Container for events to be run at destroy time. */
@@ -22,8 +22,11 @@
 #include "config.h"
 #include "global-value.h"
 #include "log.h"
+#include "simulation-local.h"
 #include "uinteger.h"
 
+#include <optional>
+
 /**
  * \file
  * \ingroup randomvariable
@@ -40,7 +43,7 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
  * The next random number generator stream number to use
  * for automatic assignment.
  */
-static uint64_t g_nextStreamIndex = 0;
+static NS_SIMULATION_LOCAL uint64_t g_nextStreamIndex = 0;
 /**
  * \relates RngSeedManager
  * \anchor GlobalValueRngSeed
@@ -70,10 +73,29 @@ static ns3::GlobalValue g_rngRun("RngRun",
                                  ns3::UintegerValue(1),
                                  ns3::MakeUintegerChecker<uint64_t>());
 
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+/**
+ * \relates RngSeedManager
+ * The seed set by the calling thread, if any, overriding RngSeed.
+ */
+static thread_local std::optional<uint32_t> g_threadSeed;
+/**
+ * \relates RngSeedManager
+ * The run set by the calling thread, if any, overriding RngRun.
+ */
+static thread_local std::optional<uint64_t> g_threadRun;
+#endif
+
 uint32_t
 RngSeedManager::GetSeed()
 {
     NS_LOG_FUNCTION_NOARGS();
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+    if (g_threadSeed)
+    {
+        return *g_threadSeed;
+    }
+#endif
     UintegerValue seedValue;
     g_rngSeed.GetValue(seedValue);
     return static_cast<uint32_t>(seedValue.Get());
@@ -83,20 +105,34 @@ void
 RngSeedManager::SetSeed(uint32_t seed)
 {
     NS_LOG_FUNCTION(seed);
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+    g_threadSeed = seed;
+#else
     Config::SetGlobal("RngSeed", UintegerValue(seed));
+#endif
 }
 
 void
 RngSeedManager::SetRun(uint64_t run)
 {
     NS_LOG_FUNCTION(run);
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+    g_threadRun = run;
+#else
     Config::SetGlobal("RngRun", UintegerValue(run));
+#endif
 }
 
 uint64_t
 RngSeedManager::GetRun()
 {
     NS_LOG_FUNCTION_NOARGS();
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+    if (g_threadRun)
+    {
+        return *g_threadRun;
+    }
+#endif
     UintegerValue value;
     g_rngRun.GetValue(value);
     uint64_t run = value.Get();
@@ -112,4 +148,11 @@ RngSeedManager::GetNextStreamIndex()
     return next;
 }
 
+void
+RngSeedManager::ResetNextStreamIndex()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_nextStreamIndex = 0;
+}
+
 } // namespace ns3
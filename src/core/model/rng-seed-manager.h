@@ -35,6 +35,11 @@ namespace ns3
  *
  * Manage the seed number and run number of the underlying
  * random number generator, and automatic assignment of stream numbers.
+ *
+ * When ns-3 is configured with \c NS3_THREAD_LOCAL_SIMULATION, the
+ * stream numbering is kept per thread, and SetSeed() and SetRun() only
+ * apply to the calling thread.  Threads which did not call them use the
+ * \c RngSeed and \c RngRun global values.
  */
 class RngSeedManager
 {
@@ -104,6 +109,17 @@ class RngSeedManager
      * \returns The next stream index.
      */
     static uint64_t GetNextStreamIndex();
+
+    /**
+     * Restart the automatic assignment of stream indices from zero,
+     * as in a new process.
+     *
+     * This is meant for a sequence of independent simulations run in
+     * one process, such as the replications of ReplicationRunner.
+     * Random variables created before this call share their streams
+     * with the ones created after it.
+     */
+    static void ResetNextStreamIndex();
 };
 
 /** Alias for compatibility. */
@@ -27,6 +27,10 @@
 #include <limits>
 #include <stdint.h>
 
+#if defined(ENABLE_THREAD_LOCAL_SIMULATION) || defined(NS3_MTP)
+#include <atomic>
+#endif
+
 /**
  * \file
  * \ingroup ptr
@@ -125,8 +129,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (--m_count == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -150,8 +153,18 @@ class SimpleRefCount : public PARENT
      * \internal
      * Note we make this mutable so that the const methods can still
      * change it.
+     *
+     * With thread-local simulations, objects such as attribute checkers
+     * and initial values are shared by the simulations of all threads,
+     * so the count is atomic.  With multithreaded simulation, events
+     * posted to another partition hold references to its objects, and
+     * the count is atomic as well.
      */
+#if defined(ENABLE_THREAD_LOCAL_SIMULATION) || defined(NS3_MTP)
+    mutable std::atomic<uint32_t> m_count;
+#else
     mutable uint32_t m_count;
+#endif
 };
 
 } // namespace ns3
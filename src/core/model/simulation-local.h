@@ -0,0 +1,68 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_SIMULATION_LOCAL_H
+#define NS3_SIMULATION_LOCAL_H
+
+/**
+ * \file
+ * \ingroup simulator
+ * NS_SIMULATION_LOCAL and NS_THREAD_CACHE macro definitions.
+ */
+
+/**
+ * \ingroup simulator
+ * \def NS_SIMULATION_LOCAL
+ * Storage class of the state owned by a simulation run.
+ *
+ * The simulator singleton, the node and channel lists, the Config
+ * root namespace, the automatic stream numbering of RngSeedManager,
+ * the packet uid counter and the MAC address allocators are declared
+ * with this macro.  It expands to \c thread_local when ns-3
+ * is configured with \c NS3_THREAD_LOCAL_SIMULATION, so that each thread
+ * can run an independent simulation, as done by ReplicationRunner.
+ * Otherwise it expands to nothing and this state is shared by the
+ * whole process.
+ *
+ * In the thread-local configuration, a thread calling Simulator
+ * functions only sees its own simulation: events cannot be scheduled
+ * from other threads, and simulator implementations running their own
+ * worker threads, such as MultithreadedSimulatorImpl, cannot be used.
+ */
+#ifdef ENABLE_THREAD_LOCAL_SIMULATION
+#define NS_SIMULATION_LOCAL thread_local
+#else
+#define NS_SIMULATION_LOCAL
+#endif
+
+/**
+ * \ingroup simulator
+ * \def NS_THREAD_CACHE
+ * Storage class of the caches which are not part of the simulation state.
+ *
+ * The free lists of Buffer, PacketMetadata and ByteTagList are declared
+ * with this macro.  It expands to \c thread_local whenever several threads
+ * may create and destroy packets at the same time, that is when ns-3 is
+ * configured with \c NS3_THREAD_LOCAL_SIMULATION or with \c NS3_MTP, so
+ * that each thread recycles memory through its own lists without locking.
+ * Otherwise it expands to nothing.
+ */
+#if defined(ENABLE_THREAD_LOCAL_SIMULATION) || defined(NS3_MTP)
+#define NS_THREAD_CACHE thread_local
+#else
+#define NS_THREAD_CACHE
+#endif
+
+#endif /* NS3_SIMULATION_LOCAL_H */
@@ -80,6 +80,7 @@ class SimulationSingleton
  *  Implementation of the templates declared above.
  ********************************************************************/
 
+#include "simulation-local.h"
 #include "simulator.h"
 
 namespace ns3
@@ -97,7 +98,7 @@ template <typename T>
 T**
 SimulationSingleton<T>::GetObject()
 {
-    static T* pobject = nullptr;
+    static NS_SIMULATION_LOCAL T* pobject = nullptr;
     if (pobject == nullptr)
     {
         pobject = new T();
@@ -40,4 +40,16 @@ SimulatorImpl::GetTypeId()
     return tid;
 }
 
+uint64_t
+SimulatorImpl::GetCancelledEventCount() const
+{
+    return 0;
+}
+
+uint64_t
+SimulatorImpl::GetPurgedEventCount() const
+{
+    return 0;
+}
+
 } // namespace ns3
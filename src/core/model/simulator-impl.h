@@ -100,6 +100,18 @@ class SimulatorImpl : public Object
     virtual uint32_t GetContext() const = 0;
     /** \copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
+    /**
+     * \copydoc Simulator::GetCancelledEventCount
+     *
+     * The default implementation does not track cancelled events.
+     */
+    virtual uint64_t GetCancelledEventCount() const;
+    /**
+     * \copydoc Simulator::GetPurgedEventCount
+     *
+     * The default implementation never purges cancelled events.
+     */
+    virtual uint64_t GetPurgedEventCount() const;
 
     /**
      * Hook called before processing each event.
@@ -18,6 +18,7 @@
  */
 #include "simulator.h"
 
+#include "abort.h"
 #include "assert.h"
 #include "des-metrics.h"
 #include "event-impl.h"
@@ -32,13 +33,22 @@
 
 #include "ns3/core-config.h"
 
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <list>
 #include <vector>
 
+#ifndef __WIN32__
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 /**
  * \file
  * \ingroup simulator
@@ -54,7 +64,7 @@ namespace ns3
 // of causing recursions leading to stack overflow
 NS_LOG_COMPONENT_DEFINE("Simulator");
 
-EventId Simulator::m_stopEvent;
+NS_SIMULATION_LOCAL EventId Simulator::m_stopEvent;
 
 /**
  * \ingroup simulator
@@ -90,7 +100,7 @@ static GlobalValue g_schedTypeImpl =
 static SimulatorImpl**
 PeekImpl()
 {
-    static SimulatorImpl* impl = nullptr;
+    static NS_SIMULATION_LOCAL SimulatorImpl* impl = nullptr;
     return &impl;
 }
 
@@ -204,6 +214,143 @@ Simulator::GetStopEvent()
     return m_stopEvent;
 }
 
+std::vector<std::string>
+Simulator::Branch(const Time& warmup,
+                  uint32_t n,
+                  Callback<void, uint32_t> setup,
+                  Callback<std::string, uint32_t> report)
+{
+    NS_LOG_FUNCTION(warmup << n);
+#ifdef __WIN32__
+    NS_FATAL_ERROR("Simulator::Branch requires fork(), which is not available on this platform");
+#else
+    NS_ABORT_MSG_IF(warmup < Now(), "Branch time " << warmup << " is in the past");
+
+    if (warmup > Now())
+    {
+        EventId stop = Stop(warmup - Now());
+        Run();
+        // Run() may have returned on another Stop() at the same time, in
+        // which case our own stop would end every branch right away.
+        Cancel(stop);
+        NS_ABORT_MSG_IF(Now() != warmup,
+                        "Simulation stopped at " << Now() << " before the branch time "
+                                                 << warmup);
+    }
+
+    // Anything buffered now would otherwise be written once per child
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+    std::fflush(nullptr);
+
+    std::vector<pid_t> pids(n, -1);
+    std::vector<int> fds(n, -1);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        int p[2];
+        NS_ABORT_MSG_IF(pipe(p) != 0, "pipe() failed: " << std::strerror(errno));
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork() failed: " << std::strerror(errno));
+        if (pid == 0)
+        {
+            close(p[0]);
+            for (uint32_t j = 0; j < i; ++j)
+            {
+                close(fds[j]);
+            }
+            if (!setup.IsNull())
+            {
+                setup(i);
+            }
+            Run();
+            std::string result = report.IsNull() ? std::string() : report(i);
+            const char* data = result.data();
+            std::size_t left = result.size();
+            while (left > 0)
+            {
+                ssize_t written = write(p[1], data, left);
+                if (written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (written <= 0)
+                {
+                    _exit(1);
+                }
+                data += written;
+                left -= written;
+            }
+            close(p[1]);
+            Destroy();
+            std::cout.flush();
+            std::cerr.flush();
+            std::clog.flush();
+            std::fflush(nullptr);
+            // Skip the static destructors and atexit handlers, they belong to the parent
+            _exit(0);
+        }
+        close(p[1]);
+        pids[i] = pid;
+        fds[i] = p[0];
+    }
+
+    // Drain all the pipes together so that no child blocks on a full pipe
+    std::vector<std::string> results(n);
+    uint32_t remaining = n;
+    while (remaining > 0)
+    {
+        std::vector<pollfd> polled;
+        std::vector<uint32_t> index;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            if (fds[i] >= 0)
+            {
+                polled.push_back({fds[i], POLLIN, 0});
+                index.push_back(i);
+            }
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "poll() failed: " << std::strerror(errno));
+            continue;
+        }
+        for (std::size_t k = 0; k < polled.size(); ++k)
+        {
+            if (polled[k].revents == 0)
+            {
+                continue;
+            }
+            uint32_t i = index[k];
+            char buffer[4096];
+            ssize_t got = read(fds[i], buffer, sizeof(buffer));
+            if (got > 0)
+            {
+                results[i].append(buffer, got);
+            }
+            else if (got == 0 || errno != EINTR)
+            {
+                close(fds[i]);
+                fds[i] = -1;
+                remaining--;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        int status;
+        while (waitpid(pids[i], &status, 0) < 0)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "waitpid() failed: " << std::strerror(errno));
+        }
+        NS_ABORT_MSG_IF(!WIFEXITED(status) || WEXITSTATUS(status) != 0,
+                        "Branch " << i << " did not exit cleanly");
+    }
+    return results;
+#endif
+}
+
 Time
 Simulator::Now()
 {
@@ -326,6 +473,18 @@ Simulator::GetEventCount()
     return GetImpl()->GetEventCount();
 }
 
+uint64_t
+Simulator::GetCancelledEventCount()
+{
+    return GetImpl()->GetCancelledEventCount();
+}
+
+uint64_t
+Simulator::GetPurgedEventCount()
+{
+    return GetImpl()->GetPurgedEventCount();
+}
+
 uint32_t
 Simulator::GetSystemId()
 {
@@ -25,9 +25,11 @@
 #include "make-event.h"
 #include "nstime.h"
 #include "object-factory.h"
+#include "simulation-local.h"
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 /**
  * @file
@@ -177,6 +179,38 @@ class Simulator
      */
     static EventId GetStopEvent();
 
+    /**
+     * Run a shared warm-up once, then continue it in independent branches.
+     *
+     * The simulation is run until @p warmup.  The process then fork()s
+     * @p n children, which run concurrently from the warmed-up state.  Child
+     * @c i calls @p setup with @c i, which can apply attribute overrides
+     * and schedule a Stop(); it then calls Run(), returns the result of
+     * @p report with @c i to the parent through a pipe, calls Destroy()
+     * and exits.
+     *
+     * The warm-up must reach @p warmup: a Stop() taking effect before
+     * @p warmup is a fatal error.
+     *
+     * The parent waits for all the children and stays at @p warmup,
+     * with its pending events untouched: it can go on with Run() or
+     * call Destroy().
+     *
+     * This is only available on POSIX systems.  The simulator
+     * implementation must not run threads of its own when Branch() is
+     * called, since only the calling thread survives a fork().
+     *
+     * @param [in] warmup The absolute time at which to branch.
+     * @param [in] n The number of branches.
+     * @param [in] setup Configures the branch given its index.
+     * @param [in] report Returns the result of the branch given its index.
+     * @returns The results of the branches, in index order.
+     */
+    static std::vector<std::string> Branch(const Time& warmup,
+                                           uint32_t n,
+                                           Callback<void, uint32_t> setup,
+                                           Callback<std::string, uint32_t> report);
+
     /**
      * Get the current simulation context.
      *
@@ -216,6 +250,23 @@ class Simulator
      */
     static uint64_t GetEventCount();
 
+    /**
+     * Get the number of cancelled events still held in the event queue.
+     *
+     * Cancel() only marks an event: it stays in the event queue until it
+     * comes due, unless the simulator implementation purges it earlier.
+     *
+     * \returns The number of cancelled events in the event queue.
+     */
+    static uint64_t GetCancelledEventCount();
+
+    /**
+     * Get the number of cancelled events purged from the event queue
+     * before they came due.
+     * \returns The total number of purged events.
+     */
+    static uint64_t GetPurgedEventCount();
+
     /**
      * @name Schedule events (in the same context) to run at a future time.
      */
@@ -531,7 +582,7 @@ class Simulator
     /**
      * Stop event (if present)
      */
-    static EventId m_stopEvent;
+    static NS_SIMULATION_LOCAL EventId m_stopEvent;
 
 }; // class Simulator
 
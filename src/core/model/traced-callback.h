@@ -22,7 +22,8 @@
 
 #include "callback.h"
 
-#include <list>
+#include <utility>
+#include <vector>
 
 /**
  * \file
@@ -30,6 +31,41 @@
  * ns3::TracedCallback declaration and template implementation.
  */
 
+/**
+ * \ingroup tracing
+ * Check whether a TracedCallback fired on a hot path has sinks connected.
+ *
+ * Use it to skip building the arguments of a trace source nobody
+ * listens to.  In optimized builds configured with \c NS3_HOT_TRACES
+ * disabled, it is always false, and the code it guards is compiled away.
+ *
+ * \param [in] traceSource The TracedCallback.
+ */
+#ifdef NS3_HOT_TRACES_DISABLE
+#define NS_HOT_TRACE_CONNECTED(traceSource) false
+#else
+#define NS_HOT_TRACE_CONNECTED(traceSource) (!(traceSource).IsEmpty())
+#endif
+
+/**
+ * \ingroup tracing
+ * Fire a TracedCallback on a hot path.
+ *
+ * The arguments are only evaluated if a sink is connected, and the
+ * statement is compiled away like NS_HOT_TRACE_CONNECTED().
+ *
+ * \param [in] traceSource The TracedCallback.
+ * \param [in] ... The arguments of the TracedCallback.
+ */
+#define NS_HOT_TRACE(traceSource, ...)                                                             \
+    do                                                                                             \
+    {                                                                                              \
+        if (NS_HOT_TRACE_CONNECTED(traceSource))                                                   \
+        {                                                                                          \
+            (traceSource)(__VA_ARGS__);                                                            \
+        }                                                                                          \
+    } while (false)
+
 namespace ns3
 {
 
@@ -45,7 +81,9 @@ namespace ns3
  *
  * This is a functor: the chain of Callbacks is invoked by
  * calling the \c operator() form with the appropriate
- * number of arguments.
+ * number of arguments.  Callbacks connected or disconnected
+ * by a Callback of the chain while it is invoked are added
+ * or removed once the invocation completes.
  *
  * \tparam Ts \explicit Types of the functor arguments.
  */
@@ -108,14 +146,42 @@ class TracedCallback
     /**@}*/
 
   private:
+    /**
+     * Add a Callback to the chain, or defer it if the chain is being invoked.
+     *
+     * \param [in] callback Callback to add to chain.
+     */
+    void Append(const Callback<void, Ts...>& callback);
+    /**
+     * Remove a Callback from the chain, or defer it if the chain is being invoked.
+     *
+     * \param [in] callback Callback to remove from the chain.
+     */
+    void Remove(const CallbackBase& callback);
+    /** Apply the changes deferred while the chain was being invoked. */
+    void ApplyDeferred() const;
+
     /**
      * Container type for holding the chain of Callbacks.
      *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+    /**
+     * The chain of Callbacks.
+     *
+     * Callbacks are stored contiguously, so that invoking the chain walks
+     * a single array.  It is mutable because the changes deferred during
+     * an invocation are applied at its end.
+     */
+    mutable CallbackList m_callbackList;
+    /**
+     * Changes made to the chain while it was being invoked, in order:
+     * a Callback to add (true) or to remove (false).
+     */
+    mutable std::vector<std::pair<bool, Callback<void, Ts...>>> m_deferred;
+    /** Number of nested invocations of the chain in progress. */
+    mutable uint32_t m_invoking;
 };
 
 } // namespace ns3
@@ -129,7 +195,9 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_callbackList(),
+      m_deferred(),
+      m_invoking(0)
 {
 }
 
@@ -142,7 +210,7 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    Append(cb);
 }
 
 template <typename... Ts>
@@ -155,24 +223,14 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    Append(realCb);
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
-    {
-        if ((*i).IsEqual(callback))
-        {
-            i = m_callbackList.erase(i);
-        }
-        else
-        {
-            i++;
-        }
-    }
+    Remove(callback);
 }
 
 template <typename... Ts>
@@ -185,16 +243,29 @@ TracedCallback<Ts...>::Disconnect(const CallbackBase& callback, std::string path
         NS_FATAL_ERROR("when disconnecting from " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    DisconnectWithoutContext(realCb);
+    Remove(realCb);
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    if (m_callbackList.empty())
     {
-        (*i)(args...);
+        return;
+    }
+    // A Callback may connect or disconnect Callbacks, which would move or
+    // destroy the Callbacks being invoked: defer these changes until the
+    // outermost invocation completes.
+    m_invoking++;
+    for (const auto& cb : m_callbackList)
+    {
+        cb(args...);
+    }
+    m_invoking--;
+    if (m_invoking == 0 && !m_deferred.empty())
+    {
+        ApplyDeferred();
     }
 }
 
@@ -205,6 +276,54 @@ TracedCallback<Ts...>::IsEmpty() const
     return m_callbackList.empty();
 }
 
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Append(const Callback<void, Ts...>& callback)
+{
+    if (m_invoking > 0)
+    {
+        m_deferred.emplace_back(true, callback);
+        return;
+    }
+    m_callbackList.push_back(callback);
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Remove(const CallbackBase& callback)
+{
+    if (m_invoking > 0)
+    {
+        // a Callback of another type cannot be in the chain
+        Callback<void, Ts...> cb;
+        if (cb.CheckType(callback) && cb.Assign(callback))
+        {
+            m_deferred.emplace_back(false, cb);
+        }
+        return;
+    }
+    std::erase_if(m_callbackList, [&callback](const auto& cb) { return cb.IsEqual(callback); });
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::ApplyDeferred() const
+{
+    auto deferred = std::move(m_deferred);
+    m_deferred.clear();
+    for (const auto& [connect, cb] : deferred)
+    {
+        if (connect)
+        {
+            m_callbackList.push_back(cb);
+        }
+        else
+        {
+            std::erase_if(m_callbackList, [&cb](const auto& i) { return i.IsEqual(cb); });
+        }
+    }
+}
+
 } // namespace ns3
 
 #endif /* TRACED_CALLBACK_H */
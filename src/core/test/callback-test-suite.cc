@@ -18,6 +18,7 @@
 #include "ns3/callback.h"
 #include "ns3/test.h"
 
+#include <array>
 #include <stdint.h>
 
 using namespace ns3;
@@ -991,6 +992,112 @@ NullifyCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(target1.IsNull(), true, "Nullified Callback reports not IsNull()");
 }
 
+/**
+ * \ingroup callback-tests
+ *
+ * Test the inline storage of small callbacks.
+ */
+class CallbackStorageTestCase : public TestCase
+{
+  public:
+    CallbackStorageTestCase();
+
+    ~CallbackStorageTestCase() override
+    {
+    }
+
+    /**
+     * Member function target.
+     *
+     * \param a first argument
+     * \param b second argument
+     * \return the sum of the arguments
+     */
+    int Target(int a, int b)
+    {
+        return a + b;
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check if the implementation of a callback is stored inline.
+     *
+     * \param cb the callback
+     * \return true if the implementation is inside the callback object
+     */
+    static bool IsInline(const CallbackBase& cb)
+    {
+        auto impl = reinterpret_cast<const char*>(PeekPointer(cb.GetImpl()));
+        auto begin = reinterpret_cast<const char*>(&cb);
+        return impl >= begin && impl < begin + sizeof(cb);
+    }
+};
+
+CallbackStorageTestCase::CallbackStorageTestCase()
+    : TestCase("Check the inline storage of small callbacks")
+{
+}
+
+void
+CallbackStorageTestCase::DoRun()
+{
+    //
+    // Member functions called on an object, with or without a bound argument,
+    // functions and small lambdas are stored inline.
+    //
+    Callback<int, int, int> member = MakeCallback(&CallbackStorageTestCase::Target, this);
+    Callback<int, int> bound = MakeCallback(&CallbackStorageTestCase::Target, this, 1);
+    Callback<int, int> function = MakeBoundCallback(&CallbackEqualityTarget, 1.5);
+    int offset = 3;
+    Callback<int, int> lambda([offset](int a) { return a + offset; });
+    NS_TEST_EXPECT_MSG_EQ(IsInline(member), true, "Member callback not inline");
+    NS_TEST_EXPECT_MSG_EQ(IsInline(bound), true, "Bound member callback not inline");
+    NS_TEST_EXPECT_MSG_EQ(IsInline(function), true, "Bound function callback not inline");
+    NS_TEST_EXPECT_MSG_EQ(IsInline(lambda), true, "Lambda callback not inline");
+    NS_TEST_EXPECT_MSG_EQ(member(1, 2), 3, "Wrong member callback value");
+    NS_TEST_EXPECT_MSG_EQ(bound(2), 3, "Wrong bound member callback value");
+    NS_TEST_EXPECT_MSG_EQ(function(2), 3, "Wrong bound function callback value");
+    NS_TEST_EXPECT_MSG_EQ(lambda(2), 5, "Wrong lambda callback value");
+
+    //
+    // Copies of an inline callback are equal to it and outlive it.
+    //
+    Callback<int, int> copy;
+    {
+        Callback<int, int> original([offset](int a) { return a * offset; });
+        copy = original;
+        NS_TEST_EXPECT_MSG_EQ(IsInline(copy), true, "Copy not inline");
+        NS_TEST_EXPECT_MSG_EQ(copy.IsEqual(original), true, "Copy not equal to the original");
+        NS_TEST_EXPECT_MSG_EQ(copy.IsEqual(lambda), false, "Distinct lambdas compared equal");
+    }
+    NS_TEST_EXPECT_MSG_EQ(copy(2), 6, "Wrong copied callback value");
+
+    //
+    // Large captures are allocated, and shared by the copies.
+    //
+    std::array<int, 32> values{};
+    values[7] = 42;
+    Callback<int> large([values]() { return values[7]; });
+    Callback<int> largeCopy = large;
+    NS_TEST_EXPECT_MSG_EQ(IsInline(large), false, "Large callback inline");
+    NS_TEST_EXPECT_MSG_EQ(PeekPointer(largeCopy.GetImpl()),
+                          PeekPointer(large.GetImpl()),
+                          "Large callback not shared");
+    NS_TEST_EXPECT_MSG_EQ(largeCopy(), 42, "Wrong large callback value");
+    NS_TEST_EXPECT_MSG_EQ(largeCopy.IsEqual(large), true, "Copy not equal to the original");
+
+    //
+    // A callback stored as a CallbackBase and assigned back stays equal.
+    //
+    CallbackBase base = bound;
+    Callback<int, int> assigned;
+    NS_TEST_EXPECT_MSG_EQ(assigned.Assign(base), true, "Assignment failed");
+    NS_TEST_EXPECT_MSG_EQ(assigned.IsEqual(bound), true, "Assigned callback not equal");
+    NS_TEST_EXPECT_MSG_EQ(assigned(4), 5, "Wrong assigned callback value");
+}
+
 /**
  * \ingroup callback-tests
  *
@@ -1197,6 +1304,7 @@ CallbackTestSuite::CallbackTestSuite()
     AddTestCase(new MakeBoundCallbackTestCase, TestCase::Duration::QUICK);
     AddTestCase(new CallbackEqualityTestCase, TestCase::Duration::QUICK);
     AddTestCase(new NullifyCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CallbackStorageTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MakeCallbackTemplatesTestCase, TestCase::Duration::QUICK);
 }
 
@@ -0,0 +1,222 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup event-impl-tests
+ * EventImpl allocator test suite
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-impl-tests EventImpl allocator tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup event-impl-tests
+ *
+ * Check that the memory of executed events is reused by the next ones.
+ */
+class EventImplReuseTestCase : public TestCase
+{
+  public:
+    EventImplReuseTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Test event.
+     * \param [in] value The value to add to the sum.
+     */
+    void Add(uint32_t value);
+
+    uint32_t m_sum; //!< Sum of the event values.
+};
+
+EventImplReuseTestCase::EventImplReuseTestCase()
+    : TestCase("Check that event memory is recycled"),
+      m_sum(0)
+{
+}
+
+void
+EventImplReuseTestCase::Add(uint32_t value)
+{
+    m_sum += value;
+}
+
+void
+EventImplReuseTestCase::DoRun()
+{
+    const uint32_t n = 100;
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        Simulator::Schedule(NanoSeconds(i), &EventImplReuseTestCase::Add, this, 1);
+    }
+    Simulator::Run();
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        Simulator::Schedule(NanoSeconds(i), &EventImplReuseTestCase::Add, this, 1);
+    }
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_sum, 2 * n, "Events did not run");
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations, n, "Wrong allocation count");
+#ifdef EVENT_IMPL_FREE_LIST
+    NS_TEST_EXPECT_MSG_EQ(after.reused - before.reused, n, "Event memory was not recycled");
+    NS_TEST_EXPECT_MSG_EQ(before.cached - after.cached, n, "Wrong number of cached blocks");
+#endif
+}
+
+/**
+ * \ingroup event-impl-tests
+ *
+ * Check events larger than the largest size class.
+ */
+class EventImplOversizeTestCase : public TestCase
+{
+  public:
+    EventImplOversizeTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventImplOversizeTestCase::EventImplOversizeTestCase()
+    : TestCase("Check events too large for the free lists")
+{
+}
+
+void
+EventImplOversizeTestCase::DoRun()
+{
+    std::array<uint8_t, 1024> payload;
+    payload.fill(7);
+    uint32_t sum = 0;
+
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+    EventImpl* ev = MakeEvent([payload, &sum]() {
+        for (auto byte : payload)
+        {
+            sum += byte;
+        }
+    });
+    ev->Invoke();
+    ev->Unref();
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+
+    NS_TEST_EXPECT_MSG_EQ(sum, 7 * payload.size(), "Event did not run");
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations, 1, "Wrong allocation count");
+    NS_TEST_EXPECT_MSG_EQ(after.deallocations - before.deallocations, 1, "Wrong release count");
+#ifdef EVENT_IMPL_FREE_LIST
+    NS_TEST_EXPECT_MSG_EQ(after.oversize - before.oversize, 1, "Event should be oversize");
+    NS_TEST_EXPECT_MSG_EQ(after.cached, before.cached, "Oversize event should not be cached");
+#endif
+}
+
+/**
+ * \ingroup event-impl-tests
+ *
+ * Check events allocated by one thread and released by another.
+ */
+class EventImplThreadTestCase : public TestCase
+{
+  public:
+    EventImplThreadTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventImplThreadTestCase::EventImplThreadTestCase()
+    : TestCase("Check events released by another thread")
+{
+}
+
+void
+EventImplThreadTestCase::DoRun()
+{
+    const uint32_t n = 50;
+    uint32_t count = 0;
+    std::vector<EventImpl*> events;
+
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+    std::thread producer([&events, &count]() {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            events.push_back(MakeEvent([&count]() { count++; }));
+        }
+        // Exercise the free list of this thread before it exits
+        events.back()->Unref();
+        events.pop_back();
+        events.push_back(MakeEvent([&count]() { count++; }));
+    });
+    producer.join();
+
+    // The producer counters are merged when the thread exits
+    EventImpl::PoolStats middle = EventImpl::GetPoolStats();
+    NS_TEST_EXPECT_MSG_EQ(middle.allocations - before.allocations, n + 1, "Wrong allocations");
+    NS_TEST_EXPECT_MSG_EQ(middle.deallocations - before.deallocations, 1, "Wrong releases");
+
+    for (auto ev : events)
+    {
+        ev->Invoke();
+        ev->Unref();
+    }
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+
+    NS_TEST_EXPECT_MSG_EQ(count, n, "Events did not run");
+    NS_TEST_EXPECT_MSG_EQ(after.deallocations - middle.deallocations, n, "Wrong releases");
+#ifdef EVENT_IMPL_FREE_LIST
+    NS_TEST_EXPECT_MSG_EQ(middle.reused - before.reused, 1, "Event memory was not recycled");
+    NS_TEST_EXPECT_MSG_EQ(after.cached - middle.cached, n, "Released events were not cached");
+#endif
+}
+
+/**
+ * \ingroup event-impl-tests
+ *
+ * \brief The EventImpl allocator TestSuite.
+ */
+class EventImplTestSuite : public TestSuite
+{
+  public:
+    EventImplTestSuite()
+        : TestSuite("event-impl", Type::UNIT)
+    {
+        AddTestCase(new EventImplReuseTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new EventImplOversizeTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new EventImplThreadTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static EventImplTestSuite g_eventImplTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,188 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-profiler.h"
+#include "ns3/make-event.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-profiler-tests EventProfiler test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup event-profiler-tests
+ * A free event function.
+ */
+static void
+ProfiledFunction()
+{
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Check the event profiles written by DefaultSimulatorImpl.
+ */
+class EventProfilerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerTestCase();
+    void DoRun() override;
+
+  private:
+    /** A member event function. */
+    void ProfiledMethod();
+    /** A virtual member event function, with the same signature. */
+    virtual void OtherProfiledMethod();
+
+    uint32_t m_calls{0};      //!< Number of ProfiledMethod() calls.
+    uint32_t m_otherCalls{0}; //!< Number of OtherProfiledMethod() calls.
+};
+
+EventProfilerTestCase::EventProfilerTestCase()
+    : TestCase("Check the event profile")
+{
+}
+
+void
+EventProfilerTestCase::ProfiledMethod()
+{
+    m_calls++;
+}
+
+void
+EventProfilerTestCase::OtherProfiledMethod()
+{
+    m_otherCalls++;
+}
+
+void
+EventProfilerTestCase::DoRun()
+{
+    // Functions with the same signature are told apart.  The names come
+    // from the exported symbols, or else from the function types.
+    EventImpl* event = MakeEvent(&EventProfilerTestCase::ProfiledMethod, this);
+    const std::string method = EventProfiler::GetEventName(event);
+    event->Unref();
+    event = MakeEvent(&EventProfilerTestCase::OtherProfiledMethod, this);
+    const std::string other = EventProfiler::GetEventName(event);
+    event->Unref();
+    event = MakeEvent(&ProfiledFunction);
+    const std::string function = EventProfiler::GetEventName(event);
+    event->Unref();
+    NS_TEST_EXPECT_MSG_NE(method.find("EventProfilerTestCase"),
+                          std::string::npos,
+                          "Wrong member name " << method);
+    NS_TEST_EXPECT_MSG_NE(other.find("EventProfilerTestCase"),
+                          std::string::npos,
+                          "Wrong member name " << other);
+    NS_TEST_EXPECT_MSG_NE(method, other, "Same name for two member functions");
+    NS_TEST_EXPECT_MSG_EQ(function.find("void (*)() at "), 0, "Wrong function name " << function);
+
+    std::string prefix = CreateTempDirFilename("event-profile");
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("ProfileSamplingPeriod", UintegerValue(2));
+    factory.Set("ProfileFilePrefix", StringValue(prefix));
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        Simulator::ScheduleWithContext(3,
+                                       MicroSeconds(i),
+                                       &EventProfilerTestCase::ProfiledMethod,
+                                       this);
+        Simulator::ScheduleWithContext(3,
+                                       MicroSeconds(50 + i),
+                                       &EventProfilerTestCase::OtherProfiledMethod,
+                                       this);
+        Simulator::Schedule(MicroSeconds(100 + i), &ProfiledFunction);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(m_calls, 20, "Wrong number of member calls");
+    NS_TEST_EXPECT_MSG_EQ(m_otherCalls, 20, "Wrong number of other member calls");
+
+    // One event in two is timed, the estimated counts add up to all the events
+    std::ifstream folded(prefix + ".folded");
+    NS_TEST_ASSERT_MSG_EQ(folded.is_open(), true, "No folded stack file");
+    std::map<std::string, uint32_t> stacks;
+    std::string line;
+    while (std::getline(folded, line))
+    {
+        std::size_t space = line.rfind(' ');
+        NS_TEST_ASSERT_MSG_NE(space, std::string::npos, "Malformed line " << line);
+        stacks[line.substr(0, space)]++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(stacks.size(), 3, "Wrong number of stacks");
+    NS_TEST_EXPECT_MSG_EQ(stacks.count("node 3;" + method), 1, "Missing member stack");
+    NS_TEST_EXPECT_MSG_EQ(stacks.count("node 3;" + other), 1, "Missing other member stack");
+    NS_TEST_EXPECT_MSG_EQ(stacks.count("no context;" + function), 1, "Missing function stack");
+
+    std::ifstream report(prefix + ".txt");
+    NS_TEST_ASSERT_MSG_EQ(report.is_open(), true, "No report file");
+    std::ostringstream oss;
+    oss << report.rdbuf();
+    NS_TEST_EXPECT_MSG_NE(oss.str().find("30 events timed, 1 in 2"),
+                          std::string::npos,
+                          "Wrong sample count");
+    NS_TEST_EXPECT_MSG_NE(oss.str().find("node 3"), std::string::npos, "Missing context");
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+  public:
+    EventProfilerTestSuite()
+        : TestSuite("event-profiler")
+    {
+        AddTestCase(new EventProfilerTestCase());
+    }
+};
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,288 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log-binary.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup log-binary-tests
+ * Binary logging test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup log-binary-tests Binary logging test suite
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LogBinaryTestSuite");
+
+namespace tests
+{
+
+/**
+ * \ingroup log-binary-tests
+ * A type whose pointers have their own operator<<.
+ */
+struct PrintedPointer
+{
+};
+
+/**
+ * \ingroup log-binary-tests
+ * Print a PrintedPointer pointer.
+ * \param [in,out] os The stream.
+ * \returns The stream.
+ */
+std::ostream&
+operator<<(std::ostream& os, const PrintedPointer* /* pointer */)
+{
+    return os << "PrintedPointer";
+}
+
+/**
+ * \ingroup log-binary-tests
+ * Check that decoding a binary log file gives the text log messages.
+ */
+class LogBinaryTextTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LogBinaryTextTestCase();
+    void DoRun() override;
+
+  private:
+    /** Log the messages. */
+    void Log();
+    /** Log the messages as text and binary, and compare them. */
+    void Check();
+
+    Ptr<Object> m_object;            //!< An object to log.
+    PrintedPointer m_printedPointer; //!< A pointer printed as text.
+};
+
+LogBinaryTextTestCase::LogBinaryTextTestCase()
+    : TestCase("Check that binary log messages decode to the text log messages")
+{
+}
+
+void
+LogBinaryTextTestCase::Log()
+{
+    std::vector<uint16_t> parameters{1, 2};
+    NS_LOG_FUNCTION(this << 42 << -7 << "chars" << std::string("string") << true << 'c'
+                         << uint8_t(200) << 1.25 << m_object << &m_printedPointer
+                         << MilliSeconds(5) << parameters);
+    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_INFO("int " << 42 << " bool " << false << " double " << 3.0 / 7 << " char " << 'x'
+                       << " object " << m_object << " pointer " << &m_printedPointer);
+    NS_LOG_DEBUG("hex " << std::hex << 255 << " dec " << std::dec << 255 << std::setw(6) << 3
+                        << " time " << Seconds(1.5));
+    NS_LOG_WARN(std::fixed << 1.0 / 3 << std::endl << "second line");
+    NS_LOG_LOGIC("");
+}
+
+void
+LogBinaryTextTestCase::Check()
+{
+    std::ostringstream text;
+    std::streambuf* clogBuffer = std::clog.rdbuf(text.rdbuf());
+    Log();
+    std::clog.rdbuf(clogBuffer);
+
+    std::string filename = CreateTempDirFilename("log-binary-test.nslog");
+    LogBinaryEnable(filename);
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryIsEnabled(), true, "Binary log not enabled");
+    Log();
+    LogBinaryDisable();
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryIsEnabled(), false, "Binary log not disabled");
+
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream decoded;
+    NS_TEST_ASSERT_MSG_EQ(LogBinaryDecode(file, decoded), true, "Can't decode the binary log");
+    NS_TEST_EXPECT_MSG_EQ(decoded.str(), text.str(), "Decoded and text messages differ");
+    NS_TEST_EXPECT_MSG_EQ(text.str().empty(), false, "No message logged");
+}
+
+void
+LogBinaryTextTestCase::DoRun()
+{
+    m_object = CreateObject<Object>();
+    LogComponentEnable("LogBinaryTestSuite", LogLevel(LOG_LEVEL_ALL | LOG_PREFIX_ALL));
+    Simulator::ScheduleWithContext(3, Seconds(1.5), &LogBinaryTextTestCase::Check, this);
+    Simulator::Run();
+    Simulator::Destroy();
+    LogComponentDisable("LogBinaryTestSuite", LOG_LEVEL_ALL);
+    m_object = nullptr;
+}
+
+/**
+ * \ingroup log-binary-tests
+ * Check the binary log messages of several threads.
+ */
+class LogBinaryThreadsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LogBinaryThreadsTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Log messages from a thread.
+     * \param [in] thread The thread index.
+     */
+    static void Log(uint32_t thread);
+
+    static constexpr uint32_t THREADS = 2;      //!< Number of logging threads.
+    static constexpr uint32_t MESSAGES = 20000; //!< Messages logged by each thread.
+};
+
+LogBinaryThreadsTestCase::LogBinaryThreadsTestCase()
+    : TestCase("Check the binary log messages of several threads")
+{
+}
+
+void
+LogBinaryThreadsTestCase::Log(uint32_t thread)
+{
+    for (uint32_t i = 0; i < MESSAGES; ++i)
+    {
+        NS_LOG_INFO("thread " << thread << " message " << i);
+    }
+}
+
+void
+LogBinaryThreadsTestCase::DoRun()
+{
+    LogComponentEnable("LogBinaryTestSuite", LOG_INFO);
+    std::string filename = CreateTempDirFilename("log-binary-threads-test.nslog");
+    LogBinaryEnable(filename);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(&LogBinaryThreadsTestCase::Log, t);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    LogBinaryDisable();
+    LogComponentDisable("LogBinaryTestSuite", LOG_LEVEL_ALL);
+
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream decoded;
+    NS_TEST_ASSERT_MSG_EQ(LogBinaryDecode(file, decoded), true, "Can't decode the binary log");
+
+    // The messages of each thread are in order
+    std::vector<uint32_t> next(THREADS, 0);
+    std::string word;
+    uint32_t thread;
+    uint32_t message;
+    while (decoded >> word >> thread >> word >> message)
+    {
+        NS_TEST_ASSERT_MSG_LT(thread, THREADS, "Wrong thread index");
+        NS_TEST_ASSERT_MSG_EQ(message, next[thread], "Message lost or out of order");
+        ++next[thread];
+    }
+    for (uint32_t t = 0; t < THREADS; ++t)
+    {
+        NS_TEST_EXPECT_MSG_EQ(next[t], MESSAGES, "Messages lost for thread " << t);
+    }
+}
+
+/**
+ * \ingroup log-binary-tests
+ * Check that LogBinaryDecode() rejects what isn't a binary log.
+ */
+class LogBinaryDecodeTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LogBinaryDecodeTestCase();
+    void DoRun() override;
+};
+
+LogBinaryDecodeTestCase::LogBinaryDecodeTestCase()
+    : TestCase("Check the decoding of invalid binary logs")
+{
+}
+
+void
+LogBinaryDecodeTestCase::DoRun()
+{
+    std::ostringstream decoded;
+    std::istringstream text("NS3 text");
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryDecode(text, decoded), false, "Text decoded");
+
+    std::istringstream empty(std::string("NS3BLOG1"));
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryDecode(empty, decoded), true, "Empty log not decoded");
+    NS_TEST_EXPECT_MSG_EQ(decoded.str(), "", "Empty log decoded to messages");
+
+    // A message record of an unknown call site
+    std::string record("NS3BLOG1");
+    uint32_t size = 14;
+    record.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    record.append(10, '\2');
+    std::istringstream unknown(record);
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryDecode(unknown, decoded), false, "Unknown call site decoded");
+
+    std::istringstream truncated(record.substr(0, record.size() - 1));
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryDecode(truncated, decoded), false, "Truncated log decoded");
+}
+
+/**
+ * \ingroup log-binary-tests
+ * Binary logging test suite.
+ */
+class LogBinaryTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    LogBinaryTestSuite();
+};
+
+LogBinaryTestSuite::LogBinaryTestSuite()
+    : TestSuite("log-binary")
+{
+    AddTestCase(new LogBinaryDecodeTestCase());
+#ifdef NS3_LOG_ENABLE
+    AddTestCase(new LogBinaryTextTestCase());
+    AddTestCase(new LogBinaryThreadsTestCase());
+#endif
+}
+
+/**
+ * \ingroup log-binary-tests
+ * LogBinaryTestSuite instance variable.
+ */
+static LogBinaryTestSuite g_logBinaryTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,145 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mpsc-queue.h"
+#include "ns3/test.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mpsc-queue-tests
+ * MpscQueue test suite
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup mpsc-queue-tests MpscQueue tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mpsc-queue-tests
+ *
+ * Push items from several threads while a consumer pops them, and check
+ * that every item is received exactly once, in order for each producer.
+ */
+class MpscQueueTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] capacity The ring size.
+     * \param [in] producers The number of producer threads.
+     */
+    MpscQueueTestCase(std::size_t capacity, uint32_t producers);
+
+  private:
+    void DoRun() override;
+
+    std::size_t m_capacity; //!< The ring size.
+    uint32_t m_producers;   //!< The number of producer threads.
+};
+
+MpscQueueTestCase::MpscQueueTestCase(std::size_t capacity, uint32_t producers)
+    : TestCase("Check MpscQueue with a ring of " + std::to_string(capacity) + " and " +
+               std::to_string(producers) + " producers"),
+      m_capacity(capacity),
+      m_producers(producers)
+{
+}
+
+void
+MpscQueueTestCase::DoRun()
+{
+    // Item: producer index, sequence number
+    typedef std::pair<uint32_t, uint32_t> Item;
+    const uint32_t n = 20000;
+
+    MpscQueue<Item> queue(m_capacity);
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "New queue should be empty");
+
+    std::atomic<uint32_t> running{m_producers};
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < m_producers; ++p)
+    {
+        producers.emplace_back([&queue, &running, p]() {
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                queue.Push({p, i});
+            }
+            running--;
+        });
+    }
+
+    std::vector<std::vector<bool>> seen(m_producers, std::vector<bool>(n, false));
+    std::vector<uint32_t> next(m_producers, 0);
+    uint32_t received = 0;
+    uint32_t duplicates = 0;
+    uint32_t reordered = 0;
+    auto consume = [&](const Item& item) {
+        received++;
+        if (seen[item.first][item.second])
+        {
+            duplicates++;
+        }
+        seen[item.first][item.second] = true;
+        if (item.second != next[item.first])
+        {
+            reordered++;
+        }
+        next[item.first] = item.second + 1;
+    };
+    while (running > 0)
+    {
+        if (!queue.IsEmpty())
+        {
+            queue.PopAll(consume);
+        }
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    queue.PopAll(consume);
+
+    NS_TEST_EXPECT_MSG_EQ(received, n * m_producers, "Items were lost");
+    NS_TEST_EXPECT_MSG_EQ(duplicates, 0, "Items were received twice");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Queue should be empty");
+    NS_TEST_EXPECT_MSG_EQ(reordered, 0, "Items were received out of order");
+}
+
+/**
+ * \ingroup mpsc-queue-tests
+ *
+ * \brief The MpscQueue TestSuite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+  public:
+    MpscQueueTestSuite()
+        : TestSuite("mpsc-queue", Type::UNIT)
+    {
+        AddTestCase(new MpscQueueTestCase(65536, 3), TestCase::Duration::QUICK);
+        AddTestCase(new MpscQueueTestCase(16, 3), TestCase::Duration::QUICK);
+    }
+};
+
+static MpscQueueTestSuite g_mpscQueueTestSuite; //!< Static variable for test initialization
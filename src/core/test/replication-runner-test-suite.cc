@@ -0,0 +1,148 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/replication-runner.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup replication-runner-tests
+ * ReplicationRunner test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup replication-runner-tests ReplicationRunner test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup replication-runner-tests
+ * Add a random number to a sum.
+ * \param [in] rv The random variable.
+ * \param [in,out] sum The sum.
+ */
+static void
+Draw(Ptr<UniformRandomVariable> rv, double* sum)
+{
+    *sum += rv->GetValue();
+}
+
+/**
+ * \ingroup replication-runner-tests
+ * A replication drawing random numbers at random times.
+ * \param [in] run The run number.
+ * \returns The sum of the numbers, the end time and the run number.
+ */
+static std::vector<double>
+Scenario(uint64_t run)
+{
+    Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+    double sum = 0;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        Simulator::Schedule(Seconds(rv->GetValue(0, 10)), &Draw, rv, &sum);
+    }
+    Simulator::Run();
+    return {sum, Simulator::Now().GetSeconds(), static_cast<double>(run)};
+}
+
+/**
+ * \ingroup replication-runner-tests
+ * Check that the replications match separate runs.
+ */
+class ReplicationRunnerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ReplicationRunnerTestCase();
+    void DoRun() override;
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase()
+    : TestCase("Check that replications match separate runs")
+{
+}
+
+void
+ReplicationRunnerTestCase::DoRun()
+{
+    // The workers must use the seed of this thread
+    uint32_t seed = RngSeedManager::GetSeed();
+    RngSeedManager::SetSeed(seed + 2);
+
+    ReplicationRunner runner;
+    runner.SetThreads(3);
+    runner.Run(MakeCallback(&Scenario), 5, 8);
+    NS_TEST_ASSERT_MSG_EQ(runner.GetN(), 8, "Wrong number of replications");
+
+    uint64_t run = RngSeedManager::GetRun();
+    double sum = 0;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        RngSeedManager::SetRun(5 + i);
+        RngSeedManager::ResetNextStreamIndex();
+        std::vector<double> expected = Scenario(5 + i);
+        Simulator::Destroy();
+
+        const std::vector<double>& result = runner.GetResult(i);
+        NS_TEST_ASSERT_MSG_EQ(result.size(), 3, "Wrong number of metrics");
+        NS_TEST_EXPECT_MSG_EQ(result[2], 5 + i, "Replications out of order");
+        NS_TEST_EXPECT_MSG_EQ(result[0], expected[0], "Different random numbers");
+        NS_TEST_EXPECT_MSG_EQ(result[1], expected[1], "Different end time");
+        sum += result[0];
+    }
+    RngSeedManager::SetRun(run);
+    RngSeedManager::SetSeed(seed);
+
+    NS_TEST_EXPECT_MSG_NE(runner.GetResult(0)[0],
+                          runner.GetResult(1)[0],
+                          "Runs are not independent");
+    NS_TEST_EXPECT_MSG_EQ_TOL(runner.GetMean(0), sum / 8, 1e-9, "Wrong mean");
+    NS_TEST_EXPECT_MSG_GT(runner.GetStddev(0), 0, "Wrong standard deviation");
+}
+
+/**
+ * \ingroup replication-runner-tests
+ * ReplicationRunner test suite.
+ */
+class ReplicationRunnerTestSuite : public TestSuite
+{
+  public:
+    ReplicationRunnerTestSuite()
+        : TestSuite("replication-runner")
+    {
+        AddTestCase(new ReplicationRunnerTestCase());
+    }
+};
+
+/**
+ * \ingroup replication-runner-tests
+ * ReplicationRunnerTestSuite instance variable.
+ */
+static ReplicationRunnerTestSuite g_replicationRunnerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -18,12 +18,18 @@
  */
 #include "ns3/calendar-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <set>
+#include <sstream>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -707,6 +713,251 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event order of a Scheduler on skewed timestamps.
+ *
+ * Events are drawn from a mixture of very short and very long delays,
+ * inserted, removed and popped in random order, and compared against
+ * a sorted reference container.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+
+  private:
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check event order on skewed timestamps with " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::set<Scheduler::Event> reference;
+    std::vector<Scheduler::Event> pending;
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    uint64_t now = 0;
+    uint32_t uid = 0;
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        double action = rng->GetValue();
+        if (action < 0.55 || reference.empty())
+        {
+            // Mostly nanosecond delays, with a few multi-second timers
+            uint64_t delay =
+                rng->GetValue() < 0.05 ? rng->GetValue(1e9, 5e9) : rng->GetInteger(0, 20);
+            Scheduler::Event ev{nullptr, {now + delay, uid++, 0}};
+            scheduler->Insert(ev);
+            reference.insert(ev);
+            pending.push_back(ev);
+        }
+        else if (action < 0.65)
+        {
+            std::size_t index = rng->GetInteger(0, pending.size() - 1);
+            Scheduler::Event ev = pending[index];
+            pending[index] = pending.back();
+            pending.pop_back();
+            if (reference.erase(ev) == 1)
+            {
+                scheduler->Remove(ev);
+            }
+        }
+        else
+        {
+            if (scheduler->PeekNext() != *reference.begin())
+            {
+                errors++;
+            }
+            Scheduler::Event ev = scheduler->RemoveNext();
+            if (ev != *reference.begin())
+            {
+                errors++;
+            }
+            reference.erase(reference.begin());
+            now = ev.key.m_ts;
+        }
+    }
+    while (!reference.empty())
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        if (ev != *reference.begin())
+        {
+            errors++;
+        }
+        reference.erase(reference.begin());
+    }
+    NS_TEST_EXPECT_MSG_EQ(errors, 0, "Events were removed out of order");
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler should be empty");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that cancelled events are purged from the event queue.
+ */
+class SimulatorPurgeTestCase : public TestCase
+{
+  public:
+    SimulatorPurgeTestCase();
+    void DoRun() override;
+
+  private:
+    /** Test event. */
+    void Event();
+
+    uint32_t m_count; //!< Number of events run.
+};
+
+SimulatorPurgeTestCase::SimulatorPurgeTestCase()
+    : TestCase("Check the purge of cancelled events"),
+      m_count(0)
+{
+}
+
+void
+SimulatorPurgeTestCase::Event()
+{
+    m_count++;
+}
+
+void
+SimulatorPurgeTestCase::DoRun()
+{
+    std::vector<EventId> events;
+    for (uint32_t i = 0; i < 4000; ++i)
+    {
+        events.push_back(Simulator::Schedule(Seconds(1) + NanoSeconds(i),
+                                             &SimulatorPurgeTestCase::Event,
+                                             this));
+    }
+
+    // The 2001st cancellation makes more than half of the queue dead
+    for (uint32_t i = 0; i < 2001; ++i)
+    {
+        Simulator::Cancel(events[i]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetPurgedEventCount(), 2001, "Events were not purged");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "Wrong cancelled count");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::IsExpired(events[0]), true, "Purged event not expired");
+    Simulator::Remove(events[0]);
+
+    // Below the threshold, cancelled events stay until they come due
+    for (uint32_t i = 3001; i < 4000; ++i)
+    {
+        Simulator::Cancel(events[i]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetPurgedEventCount(), 2001, "Events were purged");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 999, "Wrong cancelled count");
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_count, 1000, "Wrong number of events run");
+    // Purged events are counted as dequeued
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 4000, "Wrong number of events dequeued");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "Wrong cancelled count");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that Simulator::Branch continues a warm-up in independent branches.
+ */
+class SimulatorBranchTestCase : public TestCase
+{
+  public:
+    SimulatorBranchTestCase();
+    void DoRun() override;
+
+  private:
+    /** Periodic test event, adding the current step to the total. */
+    void Tick();
+    /**
+     * Branch setup.
+     * \param [in] branch The branch index.
+     */
+    void Setup(uint32_t branch);
+    /**
+     * Branch report.
+     * \param [in] branch The branch index.
+     * \returns The branch index and the total.
+     */
+    std::string Report(uint32_t branch);
+
+    uint64_t m_total; //!< Sum of the steps.
+    uint64_t m_step;  //!< Added to the total on each tick.
+};
+
+SimulatorBranchTestCase::SimulatorBranchTestCase()
+    : TestCase("Check that Simulator::Branch forks the simulation after the warm-up"),
+      m_total(0),
+      m_step(1)
+{
+}
+
+void
+SimulatorBranchTestCase::Tick()
+{
+    m_total += m_step;
+    Simulator::Schedule(Seconds(1), &SimulatorBranchTestCase::Tick, this);
+}
+
+void
+SimulatorBranchTestCase::Setup(uint32_t branch)
+{
+    m_step = branch + 2;
+    Simulator::Stop(Seconds(10));
+}
+
+std::string
+SimulatorBranchTestCase::Report(uint32_t branch)
+{
+    std::ostringstream oss;
+    oss << branch << ":" << m_total;
+    return oss.str();
+}
+
+void
+SimulatorBranchTestCase::DoRun()
+{
+    Simulator::Schedule(Seconds(0.5), &SimulatorBranchTestCase::Tick, this);
+    // A stop at the branch time must not leak into the branches
+    Simulator::Stop(Seconds(10));
+    std::vector<std::string> results =
+        Simulator::Branch(Seconds(10),
+                          3,
+                          MakeCallback(&SimulatorBranchTestCase::Setup, this),
+                          MakeCallback(&SimulatorBranchTestCase::Report, this));
+
+    // 10 ticks in the warm-up, then 10 ticks of branch + 2
+    NS_TEST_ASSERT_MSG_EQ(results.size(), 3, "Wrong number of results");
+    NS_TEST_EXPECT_MSG_EQ(results[0], "0:30", "Wrong result for branch 0");
+    NS_TEST_EXPECT_MSG_EQ(results[1], "1:40", "Wrong result for branch 1");
+    NS_TEST_EXPECT_MSG_EQ(results[2], "2:50", "Wrong result for branch 2");
+
+    // The parent is left untouched at the branch time
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(10), "Parent moved past the branch time");
+    NS_TEST_EXPECT_MSG_EQ(m_total, 10, "Parent ran branch events");
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +981,20 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorPurgeTestCase, TestCase::Duration::QUICK);
+#ifndef __WIN32__
+        AddTestCase(new SimulatorBranchTestCase, TestCase::Duration::QUICK);
+#endif
+
+        for (auto scheduler : {MapScheduler::GetTypeId(),
+                               CalendarScheduler::GetTypeId(),
+                               LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(scheduler);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        }
     }
 };
 
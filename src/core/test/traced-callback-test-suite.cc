@@ -133,6 +133,128 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check Callbacks connecting and disconnecting
+ * Callbacks while the chain is invoked.
+ */
+class ReentrantTracedCallbackTestCase : public TestCase
+{
+  public:
+    ReentrantTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback connecting CbTwo() and disconnecting itself.
+     * \param a First parameter.
+     */
+    void CbOne(int a);
+    /**
+     * Callback counting its calls.
+     * \param a First parameter.
+     */
+    void CbTwo(int a);
+
+    TracedCallback<int> m_trace; //!< The traced callback.
+    uint32_t m_one;              //!< Number of calls of the first callback.
+    uint32_t m_two;              //!< Number of calls of the second callback.
+};
+
+ReentrantTracedCallbackTestCase::ReentrantTracedCallbackTestCase()
+    : TestCase("Check connecting and disconnecting from a TracedCallback being invoked")
+{
+}
+
+void
+ReentrantTracedCallbackTestCase::CbOne(int a)
+{
+    m_one++;
+    m_trace.ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbTwo, this));
+    m_trace.DisconnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbOne, this));
+    if (a > 0)
+    {
+        // a nested invocation does not apply the changes either
+        m_trace(a - 1);
+    }
+}
+
+void
+ReentrantTracedCallbackTestCase::CbTwo(int /* a */)
+{
+    m_two++;
+}
+
+void
+ReentrantTracedCallbackTestCase::DoRun()
+{
+    m_one = 0;
+    m_two = 0;
+    m_trace.ConnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbOne, this));
+
+    //
+    // The changes made by CbOne take effect when the outermost invocation
+    // completes: CbOne is called by both invocations, and CbTwo by none.
+    //
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_one, 2, "Callback CbOne not called by each invocation");
+    NS_TEST_ASSERT_MSG_EQ(m_two, 0, "Callback CbTwo called before the invocation completed");
+
+    //
+    // CbOne connected CbTwo twice and disconnected itself.
+    //
+    m_trace(0);
+    NS_TEST_ASSERT_MSG_EQ(m_one, 2, "Callback CbOne unexpectedly called");
+    NS_TEST_ASSERT_MSG_EQ(m_two, 2, "Callback CbTwo not connected twice");
+
+    m_trace.DisconnectWithoutContext(MakeCallback(&ReentrantTracedCallbackTestCase::CbTwo, this));
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "Callbacks still connected");
+}
+
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check that NS_HOT_TRACE() only evaluates its
+ * arguments when a Callback is connected.
+ */
+class HotTracedCallbackTestCase : public TestCase
+{
+  public:
+    HotTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HotTracedCallbackTestCase::HotTracedCallbackTestCase()
+    : TestCase("Check NS_HOT_TRACE")
+{
+}
+
+void
+HotTracedCallbackTestCase::DoRun()
+{
+    TracedCallback<int> trace;
+    int evaluated = 0;
+    int received = 0;
+    auto argument = [&evaluated]() { return ++evaluated; };
+
+    NS_HOT_TRACE(trace, argument());
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 0, "Argument evaluated without any sink");
+
+    trace.ConnectWithoutContext(Callback<void, int>([&received](int a) { received = a; }));
+    NS_HOT_TRACE(trace, argument());
+#ifdef NS3_HOT_TRACES_DISABLE
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 0, "Argument of a disabled trace source evaluated");
+    NS_TEST_ASSERT_MSG_EQ(received, 0, "Disabled trace source fired");
+#else
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 1, "Argument not evaluated");
+    NS_TEST_ASSERT_MSG_EQ(received, 1, "Trace source not fired");
+#endif
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -148,6 +270,8 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ReentrantTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new HotTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
@@ -584,7 +584,7 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
 
     if (ipv4Interface->IsUp())
     {
-        m_rxTrace(packet, this, interface);
+        NS_HOT_TRACE(m_rxTrace, packet, this, interface);
     }
     else
     {
@@ -731,7 +731,7 @@ Ipv4L3Protocol::CallTxTrace(const Ipv4Header& ipHeader,
                             Ptr<Ipv4> ipv4,
                             uint32_t interface)
 {
-    if (!m_txTrace.IsEmpty())
+    if (NS_HOT_TRACE_CONNECTED(m_txTrace))
     {
         Ptr<Packet> packetCopy = packet->Copy();
         packetCopy->AddHeader(ipHeader);
@@ -799,7 +799,7 @@ Ipv4L3Protocol::Send(Ptr<Packet> packet,
         // 1b) with a valid gateway
         NS_LOG_LOGIC("Ipv4L3Protocol::Send case 1b:  passed in with route and valid gateway");
         int32_t interface = GetInterfaceForDevice(route->GetOutputDevice());
-        m_sendOutgoingTrace(ipHeader, packet, interface);
+        NS_HOT_TRACE(m_sendOutgoingTrace, ipHeader, packet, interface);
         if (m_enableDpd && ipHeader.GetDestination().IsMulticast())
         {
             UpdateDuplicate(packet, ipHeader);
@@ -1042,7 +1042,7 @@ Ipv4L3Protocol::IpMulticastForward(Ptr<Ipv4MulticastRoute> mrtentry,
         rtentry->SetGateway(Ipv4Address::GetAny());
         rtentry->SetOutputDevice(GetNetDevice(interface));
 
-        m_multicastForwardTrace(ipHeader, packet, interface);
+        NS_HOT_TRACE(m_multicastForwardTrace, ipHeader, packet, interface);
         SendRealOut(rtentry, packet, ipHeader);
     }
 }
@@ -1081,7 +1081,7 @@ Ipv4L3Protocol::IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv
         packet->AddPacketTag(priorityTag);
     }
 
-    m_unicastForwardTrace(ipHeader, packet, interface);
+    NS_HOT_TRACE(m_unicastForwardTrace, ipHeader, packet, interface);
     SendRealOut(rtentry, packet, ipHeader);
 }
 
@@ -1106,7 +1106,7 @@ Ipv4L3Protocol::LocalDeliver(Ptr<const Packet> packet, const Ipv4Header& ip, uin
         ipHeader.SetPayloadSize(p->GetSize());
     }
 
-    m_localDeliverTrace(ipHeader, p, iif);
+    NS_HOT_TRACE(m_localDeliverTrace, ipHeader, p, iif);
 
     Ptr<IpL4Protocol> protocol = GetProtocol(ipHeader.GetProtocol(), iif);
     if (protocol)
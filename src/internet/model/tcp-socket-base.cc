@@ -1332,7 +1332,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         }
     }
 
-    m_rxTrace(packet, tcpHeader, this);
+    NS_HOT_TRACE(m_rxTrace, packet, tcpHeader, this);
 
     if (tcpHeader.GetFlags() & TcpHeader::SYN)
     {
@@ -1448,7 +1448,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
             h.SetDestinationPort(tcpHeader.GetSourcePort());
             h.SetWindowSize(AdvertisedWindowSize());
             AddOptions(h);
-            m_txTrace(p, h, this);
+            NS_HOT_TRACE(m_txTrace, p, h, this);
             m_tcp->SendPacket(p, h, toAddress, fromAddress, m_boundnetdevice);
         }
         break;
@@ -2832,7 +2832,7 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
         NS_LOG_INFO("Sending a pure ACK, acking seq " << m_tcb->m_rxBuffer->NextRxSequence());
     }
 
-    m_txTrace(p, header, this);
+    NS_HOT_TRACE(m_txTrace, p, header, this);
 
     if (m_endPoint != nullptr)
     {
@@ -3213,7 +3213,7 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
     }
 
-    m_txTrace(p, header, this);
+    NS_HOT_TRACE(m_txTrace, p, header, this);
 
     if (m_endPoint)
     {
@@ -3929,7 +3929,7 @@ TcpSocketBase::PersistTimeout()
         ipTclassTag.SetTclass(MarkEcnCodePoint(0, m_tcb->m_ectCodePoint));
         p->AddPacketTag(ipTclassTag);
     }
-    m_txTrace(p, tcpHeader, this);
+    NS_HOT_TRACE(m_txTrace, p, tcpHeader, this);
 
     if (m_endPoint != nullptr)
     {
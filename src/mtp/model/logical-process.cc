@@ -0,0 +1,287 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::LogicalProcess.
+ */
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace ns3
+{
+
+// Logging in this file is largely avoided, see default-simulator-impl.cc
+NS_LOG_COMPONENT_DEFINE("LogicalProcess");
+
+LogicalProcess::LogicalProcess(uint32_t id, ObjectFactory schedulerFactory)
+    : m_id(id),
+      m_uid(EventId::UID::VALID),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentTs(0),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_eventCount(0),
+      m_sequence(0),
+      m_mailboxMinTs(std::numeric_limits<uint64_t>::max())
+{
+    NS_LOG_FUNCTION(this << id);
+    m_events = schedulerFactory.Create<Scheduler>();
+}
+
+LogicalProcess::~LogicalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LogicalProcess::Dispose()
+{
+    NS_LOG_FUNCTION(this);
+    ReceiveMessages();
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        next.impl->Unref();
+    }
+    m_events = nullptr;
+}
+
+void
+LogicalProcess::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+    while (!m_events->IsEmpty())
+    {
+        scheduler->Insert(m_events->RemoveNext());
+    }
+    m_events = scheduler;
+}
+
+uint32_t
+LogicalProcess::GetId() const
+{
+    return m_id;
+}
+
+EventId
+LogicalProcess::Insert(uint64_t ts, uint32_t context, EventImpl* event)
+{
+    NS_ASSERT_MSG(ts >= m_currentTs, "LogicalProcess::Insert(): event in the past");
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+LogicalProcess::Adopt(const Scheduler::Event& ev)
+{
+    m_events->Insert(ev);
+}
+
+void
+LogicalProcess::Post(uint64_t ts,
+                     uint32_t context,
+                     uint32_t sourceId,
+                     uint64_t sequence,
+                     EventImpl* event)
+{
+    std::unique_lock lock{m_mailboxMutex};
+    m_mailbox.push_back({ts, context, sourceId, sequence, event});
+    m_mailboxMinTs = std::min(m_mailboxMinTs, ts);
+}
+
+void
+LogicalProcess::ReceiveMessages()
+{
+    std::vector<Message> messages;
+    {
+        std::unique_lock lock{m_mailboxMutex};
+        if (m_mailbox.empty())
+        {
+            return;
+        }
+        m_mailbox.swap(messages);
+        m_mailboxMinTs = std::numeric_limits<uint64_t>::max();
+    }
+
+    // Hand out uids in an order which does not depend on thread timing
+    std::sort(messages.begin(), messages.end(), [](const Message& a, const Message& b) {
+        return std::tie(a.ts, a.sourceId, a.sequence) < std::tie(b.ts, b.sourceId, b.sequence);
+    });
+    for (const auto& message : messages)
+    {
+        // Posts from foreign threads may lag behind the local clock
+        Insert(std::max(message.ts, m_currentTs), message.context, message.event);
+    }
+}
+
+void
+LogicalProcess::ProcessOneEvent()
+{
+    Scheduler::Event next = m_events->RemoveNext();
+
+    NS_ASSERT(next.key.m_ts >= m_currentTs);
+    m_eventCount++;
+
+    m_currentTs = next.key.m_ts;
+    m_currentContext = next.key.m_context;
+    m_currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+LogicalProcess::ProcessUntil(uint64_t windowEnd, const std::atomic<bool>& stop)
+{
+    ReceiveMessages();
+    while (!m_events->IsEmpty() && m_events->PeekNext().key.m_ts < windowEnd &&
+           !stop.load(std::memory_order_relaxed))
+    {
+        ProcessOneEvent();
+    }
+}
+
+void
+LogicalProcess::ProcessNextTimestamp(const std::atomic<bool>& stop)
+{
+    ReceiveMessages();
+    if (m_events->IsEmpty())
+    {
+        return;
+    }
+    uint64_t ts = m_events->PeekNext().key.m_ts;
+    while (!m_events->IsEmpty() && m_events->PeekNext().key.m_ts == ts &&
+           !stop.load(std::memory_order_relaxed))
+    {
+        ProcessOneEvent();
+        ReceiveMessages();
+    }
+}
+
+uint64_t
+LogicalProcess::NextTs() const
+{
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    if (!m_events->IsEmpty())
+    {
+        next = m_events->PeekNext().key.m_ts;
+    }
+    std::unique_lock lock{m_mailboxMutex};
+    return std::min(next, m_mailboxMinTs);
+}
+
+bool
+LogicalProcess::IsEmpty() const
+{
+    return NextTs() == std::numeric_limits<uint64_t>::max();
+}
+
+void
+LogicalProcess::Remove(const EventId& id)
+{
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+bool
+LogicalProcess::IsExpired(const EventId& id) const
+{
+    return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
+           (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+uint64_t
+LogicalProcess::NextSequence()
+{
+    return m_sequence++;
+}
+
+uint64_t
+LogicalProcess::GetCurrentTs() const
+{
+    return m_currentTs;
+}
+
+void
+LogicalProcess::SetCurrentTs(uint64_t ts)
+{
+    NS_ASSERT(ts >= m_currentTs);
+    m_currentTs = ts;
+}
+
+uint32_t
+LogicalProcess::GetContext() const
+{
+    return m_currentContext;
+}
+
+uint64_t
+LogicalProcess::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+uint32_t
+LogicalProcess::GetUid() const
+{
+    return m_uid;
+}
+
+void
+LogicalProcess::SetUid(uint32_t uid)
+{
+    m_uid = uid;
+}
+
+std::vector<Scheduler::Event>
+LogicalProcess::RemoveAll()
+{
+    std::vector<Scheduler::Event> events;
+    while (!m_events->IsEmpty())
+    {
+        events.push_back(m_events->RemoveNext());
+    }
+    return events;
+}
+
+} // namespace ns3
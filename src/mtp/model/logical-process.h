@@ -0,0 +1,222 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::LogicalProcess.
+ */
+
+#ifndef NS3_LOGICAL_PROCESS_H
+#define NS3_LOGICAL_PROCESS_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup mtp
+ *
+ * \brief One partition of a multithreaded simulation.
+ *
+ * A LogicalProcess owns the event queue, the clock and the event
+ * counters of the nodes assigned to it.  It is only ever driven by a
+ * single thread at a time, so none of the queue operations are locked.
+ *
+ * Events scheduled by other logical processes are not inserted
+ * directly: they are posted to a mailbox, protected by a mutex, and
+ * moved into the event queue by the owning thread at the start of the
+ * next synchronization window.  The mailbox is sorted before being
+ * drained so that the resulting event order does not depend on the
+ * thread interleaving.
+ */
+class LogicalProcess
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] id The index of this logical process.
+     * \param [in] schedulerFactory The factory used to create the event queue.
+     */
+    LogicalProcess(uint32_t id, ObjectFactory schedulerFactory);
+    /** Destructor. */
+    ~LogicalProcess();
+
+    /** Release all pending events, including those still in the mailbox. */
+    void Dispose();
+
+    /**
+     * Replace the event queue, moving any pending events over.
+     *
+     * \param [in] schedulerFactory The factory used to create the new queue.
+     */
+    void SetScheduler(ObjectFactory schedulerFactory);
+
+    /** \return The index of this logical process. */
+    uint32_t GetId() const;
+
+    /**
+     * Insert an event at an absolute time into the local event queue.
+     *
+     * \param [in] ts The absolute event timestamp.
+     * \param [in] context The event context.
+     * \param [in] event The event to insert.
+     * \return The id of the inserted event.
+     */
+    EventId Insert(uint64_t ts, uint32_t context, EventImpl* event);
+
+    /**
+     * Insert an already keyed event, taken from another logical process
+     * while the simulation is not running.
+     *
+     * \param [in] ev The event to adopt.
+     */
+    void Adopt(const Scheduler::Event& ev);
+
+    /**
+     * Post an event from another thread.  May be called concurrently.
+     *
+     * \param [in] ts The absolute event timestamp.
+     * \param [in] context The event context.
+     * \param [in] sourceId The index of the posting logical process.
+     * \param [in] sequence The posting process message sequence number.
+     * \param [in] event The event to post.
+     */
+    void Post(uint64_t ts,
+              uint32_t context,
+              uint32_t sourceId,
+              uint64_t sequence,
+              EventImpl* event);
+
+    /** Move all posted events into the local event queue. */
+    void ReceiveMessages();
+
+    /**
+     * Process all events with a timestamp strictly smaller than \p windowEnd.
+     *
+     * \param [in] windowEnd End of the granted time window.
+     * \param [in] stop Flag checked after each event to interrupt processing.
+     */
+    void ProcessUntil(uint64_t windowEnd, const std::atomic<bool>& stop);
+
+    /**
+     * Process all the events sharing the earliest timestamp.
+     *
+     * \param [in] stop Flag checked after each event to interrupt processing.
+     */
+    void ProcessNextTimestamp(const std::atomic<bool>& stop);
+
+    /**
+     * Get the timestamp of the next event, including posted events
+     * that have not been received yet.
+     *
+     * \return The next event timestamp, or UINT64_MAX if there are none.
+     */
+    uint64_t NextTs() const;
+
+    /** \return \c true if there are no pending events at all. */
+    bool IsEmpty() const;
+
+    /**
+     * Remove an event from the local event queue.
+     *
+     * \param [in] id The event to remove.
+     */
+    void Remove(const EventId& id);
+
+    /**
+     * Check whether an event of this logical process has run or was cancelled.
+     *
+     * \param [in] id The event to check.
+     * \return \c true if the event has expired.
+     */
+    bool IsExpired(const EventId& id) const;
+
+    /**
+     * Get the next message sequence number used when posting to other
+     * logical processes.
+     *
+     * \return The sequence number.
+     */
+    uint64_t NextSequence();
+
+    /** \return The timestamp of the current event. */
+    uint64_t GetCurrentTs() const;
+    /**
+     * Advance the clock without running an event.
+     * \param [in] ts The new timestamp, which must not be in the past.
+     */
+    void SetCurrentTs(uint64_t ts);
+    /** \return The context of the current event. */
+    uint32_t GetContext() const;
+    /** \return The number of events executed so far. */
+    uint64_t GetEventCount() const;
+    /** \return The next event unique id, for seeding other processes. */
+    uint32_t GetUid() const;
+    /**
+     * Set the next event unique id.
+     * \param [in] uid The first uid this process will hand out.
+     */
+    void SetUid(uint32_t uid);
+    /**
+     * Take all the events out of the local event queue.
+     * \return The events, in timestamp order.
+     */
+    std::vector<Scheduler::Event> RemoveAll();
+
+  private:
+    /** Run the earliest local event. */
+    void ProcessOneEvent();
+
+    /** An event posted by another logical process. */
+    struct Message
+    {
+        uint64_t ts;       /**< Absolute event timestamp. */
+        uint32_t context;  /**< Event context. */
+        uint32_t sourceId; /**< Posting logical process. */
+        uint64_t sequence; /**< Posting process sequence number. */
+        EventImpl* event;  /**< The event implementation. */
+    };
+
+    uint32_t m_id;           /**< Index of this logical process. */
+    Ptr<Scheduler> m_events; /**< The event priority queue. */
+
+    uint32_t m_uid;            /**< Next event unique id. */
+    uint32_t m_currentUid;     /**< Unique id of the current event. */
+    uint64_t m_currentTs;      /**< Timestamp of the current event. */
+    uint32_t m_currentContext; /**< Execution context of the current event. */
+    uint64_t m_eventCount;     /**< The event count. */
+    uint64_t m_sequence;       /**< Outgoing message sequence number. */
+
+    std::vector<Message> m_mailbox;    /**< Events posted by other threads. */
+    uint64_t m_mailboxMinTs;           /**< Earliest timestamp in the mailbox. */
+    mutable std::mutex m_mailboxMutex; /**< Protects the mailbox. */
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOGICAL_PROCESS_H */
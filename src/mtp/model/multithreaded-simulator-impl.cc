@@ -0,0 +1,673 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/assert.h"
+#include "ns3/boolean.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+/**
+ * \ingroup mtp
+ * The logical process driven by the calling thread, or \c nullptr
+ * outside of a time window.
+ */
+static thread_local LogicalProcess* g_currentLp = nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of partitions, each one run by its own thread. "
+                          "Zero means the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = false;
+    m_maxThreads = 0;
+    m_partitioned = false;
+    m_lookAhead = std::numeric_limits<uint64_t>::max();
+    m_mainThreadId = std::this_thread::get_id();
+    m_window = 0;
+    m_windowEnd = 0;
+    m_running = 0;
+    m_terminate = false;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    StopWorkers();
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    StopWorkers();
+    for (auto& lp : m_lps)
+    {
+        lp->Dispose();
+    }
+    m_lps.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_schedulerFactory = schedulerFactory;
+    if (m_lps.empty())
+    {
+        m_lps.push_back(std::make_unique<LogicalProcess>(0, schedulerFactory));
+        return;
+    }
+    for (auto& lp : m_lps)
+    {
+        lp->SetScheduler(schedulerFactory);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::BoundLookAhead(const Time lookAhead)
+{
+    if (lookAhead.IsStrictlyPositive())
+    {
+        NS_LOG_FUNCTION(this << lookAhead);
+        m_lookAhead = std::min(m_lookAhead, static_cast<uint64_t>(lookAhead.GetTimeStep()));
+    }
+    else
+    {
+        NS_LOG_WARN("attempted to set lookahead to a non-positive time: " << lookAhead);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_lps.size() - 1;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookAhead() const
+{
+    if (m_lookAhead == std::numeric_limits<uint64_t>::max())
+    {
+        return GetMaximumSimulationTime();
+    }
+    return TimeStep(m_lookAhead);
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_partitioned);
+
+    const uint32_t nNodes = NodeList::GetNNodes();
+
+    // Nodes which must stay together are merged into the same component
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t n) {
+        while (parent[n] != n)
+        {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+
+    /** A point-to-point link which may be cut between partitions. */
+    struct Link
+    {
+        Ptr<Channel> channel; //!< The link
+        uint32_t a;           //!< First node
+        uint32_t b;           //!< Second node
+        uint64_t delay;       //!< Link delay
+    };
+
+    std::vector<Link> links;
+    std::vector<bool> seen(ChannelList::GetNChannels(), false);
+    for (auto node = NodeList::Begin(); node != NodeList::End(); ++node)
+    {
+        for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+        {
+            Ptr<NetDevice> device = (*node)->GetDevice(i);
+            Ptr<Channel> channel = device->GetChannel();
+            if (!channel || seen[channel->GetId()])
+            {
+                continue;
+            }
+            seen[channel->GetId()] = true;
+
+            std::vector<uint32_t> ends;
+            for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
+            {
+                ends.push_back(channel->GetDevice(j)->GetNode()->GetId());
+            }
+
+            // A cut link must hand deep copies of its packets to the other
+            // partition, since packets share their data with their copies
+            TimeValue delay;
+            BooleanValue deepCopy;
+            if (device->IsPointToPoint() && ends.size() == 2 &&
+                channel->GetAttributeFailSafe("Delay", delay) && delay.Get().IsStrictlyPositive() &&
+                channel->GetAttributeFailSafe("DeepCopy", deepCopy))
+            {
+                auto ts = static_cast<uint64_t>(delay.Get().GetTimeStep());
+                links.push_back({channel, ends[0], ends[1], ts});
+                continue;
+            }
+            for (auto end : ends)
+            {
+                parent[find(end)] = find(ends.front());
+            }
+        }
+    }
+
+    // Walk the components breadth-first so that neighbours share a partition
+    std::vector<std::vector<uint32_t>> adjacency(nNodes);
+    for (const auto& link : links)
+    {
+        adjacency[link.a].push_back(link.b);
+        adjacency[link.b].push_back(link.a);
+    }
+    std::vector<std::vector<uint32_t>> members(nNodes);
+    for (uint32_t n = 0; n < nNodes; ++n)
+    {
+        members[find(n)].push_back(n);
+    }
+    std::vector<uint32_t> order;
+    std::vector<bool> visited(nNodes, false);
+    for (uint32_t root = 0; root < nNodes; ++root)
+    {
+        if (members[root].empty() || visited[root])
+        {
+            continue;
+        }
+        std::queue<uint32_t> pending;
+        pending.push(root);
+        visited[root] = true;
+        while (!pending.empty())
+        {
+            uint32_t component = pending.front();
+            pending.pop();
+            order.push_back(component);
+            for (auto n : members[component])
+            {
+                for (auto neighbour : adjacency[n])
+                {
+                    uint32_t other = find(neighbour);
+                    if (!visited[other])
+                    {
+                        visited[other] = true;
+                        pending.push(other);
+                    }
+                }
+            }
+        }
+    }
+
+    uint32_t threads = m_maxThreads;
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    const uint32_t wanted = std::max<uint32_t>(1, std::min<uint32_t>(threads, order.size()));
+    const uint32_t target = (nNodes + wanted - 1) / wanted;
+
+    m_nodePartition.assign(nNodes, 1);
+    uint32_t partition = 1;
+    uint32_t load = 0;
+    for (auto component : order)
+    {
+        if (load >= target && partition < wanted)
+        {
+            partition++;
+            load = 0;
+        }
+        for (auto n : members[component])
+        {
+            m_nodePartition[n] = partition;
+        }
+        load += members[component].size();
+    }
+
+    for (const auto& link : links)
+    {
+        if (m_nodePartition[link.a] != m_nodePartition[link.b])
+        {
+            m_lookAhead = std::min(m_lookAhead, link.delay);
+            link.channel->SetAttribute("DeepCopy", BooleanValue(true));
+        }
+    }
+
+    // Hand the events scheduled so far to their partition
+    LogicalProcess* system = m_lps.front().get();
+    system->ReceiveMessages();
+    for (uint32_t i = 1; i <= partition; ++i)
+    {
+        m_lps.push_back(std::make_unique<LogicalProcess>(i, m_schedulerFactory));
+        m_lps.back()->SetUid(system->GetUid());
+        m_lps.back()->SetCurrentTs(system->GetCurrentTs());
+    }
+    for (const auto& ev : system->RemoveAll())
+    {
+        if (ev.key.m_context < nNodes)
+        {
+            m_lps[m_nodePartition[ev.key.m_context]]->Adopt(ev);
+        }
+        else
+        {
+            system->Adopt(ev);
+        }
+    }
+
+    NS_LOG_INFO("split " << nNodes << " nodes into " << partition
+                         << " partitions, lookahead " << GetLookAhead());
+
+    for (uint32_t i = 2; i <= partition; ++i)
+    {
+        m_workers.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop, this, m_lps[i].get());
+    }
+    m_partitioned = true;
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop(LogicalProcess* lp)
+{
+    g_currentLp = lp;
+    uint64_t window = 0;
+    while (true)
+    {
+        uint64_t windowEnd;
+        {
+            std::unique_lock lock{m_windowMutex};
+            m_windowStart.wait(lock, [this, window] { return m_terminate || m_window != window; });
+            if (m_terminate)
+            {
+                break;
+            }
+            window = m_window;
+            windowEnd = m_windowEnd;
+        }
+        lp->ProcessUntil(windowEnd, m_stop);
+        {
+            std::unique_lock lock{m_windowMutex};
+            m_running--;
+            if (m_running == 0)
+            {
+                m_windowDone.notify_one();
+            }
+        }
+    }
+    g_currentLp = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow(uint64_t windowEnd)
+{
+    {
+        std::unique_lock lock{m_windowMutex};
+        m_windowEnd = windowEnd;
+        m_running = m_workers.size();
+        m_window++;
+    }
+    m_windowStart.notify_all();
+
+    // The main thread takes care of the first partition
+    g_currentLp = m_lps[1].get();
+    m_lps[1]->ProcessUntil(windowEnd, m_stop);
+    g_currentLp = nullptr;
+
+    std::unique_lock lock{m_windowMutex};
+    m_windowDone.wait(lock, [this] { return m_running == 0; });
+}
+
+void
+MultithreadedSimulatorImpl::StopWorkers()
+{
+    {
+        std::unique_lock lock{m_windowMutex};
+        m_terminate = true;
+    }
+    m_windowStart.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetCurrentLp() const
+{
+    if (g_currentLp != nullptr)
+    {
+        return g_currentLp;
+    }
+    return m_lps.front().get();
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetLp(uint32_t context) const
+{
+    if (context < m_nodePartition.size())
+    {
+        return m_lps[m_nodePartition[context]].get();
+    }
+    // Events which do not belong to a node stay where they were scheduled
+    return GetCurrentLp();
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetEventLp(const EventId& id) const
+{
+    LogicalProcess* lp = GetLp(id.GetContext());
+    NS_ASSERT_MSG(g_currentLp == nullptr || lp == g_currentLp,
+                  "Event " << id.GetUid() << " of node " << id.GetContext()
+                           << " belongs to another partition");
+    return lp;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    return std::all_of(m_lps.begin(), m_lps.end(), [](const auto& lp) { return lp->IsEmpty(); });
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    m_stop = false;
+
+    constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+    LogicalProcess* system = m_lps.front().get();
+    while (!m_stop)
+    {
+        uint64_t nodeNext = NEVER;
+        for (std::size_t i = 1; i < m_lps.size(); ++i)
+        {
+            nodeNext = std::min(nodeNext, m_lps[i]->NextTs());
+        }
+        uint64_t systemNext = system->NextTs();
+        if (nodeNext == NEVER && systemNext == NEVER)
+        {
+            break;
+        }
+
+        // Events without a node context run alone, before any node event
+        // with the same timestamp
+        if (systemNext <= nodeNext)
+        {
+            system->ProcessNextTimestamp(m_stop);
+            continue;
+        }
+
+        system->SetCurrentTs(std::max(system->GetCurrentTs(), nodeNext));
+        uint64_t windowEnd = NEVER;
+        if (m_lookAhead < NEVER - nodeNext)
+        {
+            windowEnd = nodeNext + m_lookAhead;
+        }
+        RunWindow(std::min(windowEnd, systemNext));
+    }
+
+    uint64_t last = system->GetCurrentTs();
+    for (const auto& lp : m_lps)
+    {
+        last = std::max(last, lp->GetCurrentTs());
+    }
+    system->SetCurrentTs(last);
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(g_currentLp != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    LogicalProcess* lp = GetCurrentLp();
+    return lp->Insert(lp->GetCurrentTs() + delay.GetTimeStep(), lp->GetContext(), event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    LogicalProcess* source = GetCurrentLp();
+    LogicalProcess* target = GetLp(context);
+    uint64_t ts = source->GetCurrentTs() + delay.GetTimeStep();
+
+    if (g_currentLp == nullptr && m_mainThreadId != std::this_thread::get_id())
+    {
+        // Foreign thread, such as a device reader: no ordering guarantee
+        target->Post(ts, context, std::numeric_limits<uint32_t>::max(), 0, event);
+    }
+    else if (target == source)
+    {
+        source->Insert(ts, context, event);
+    }
+    else
+    {
+        NS_ASSERT_MSG(g_currentLp == nullptr || ts >= m_windowEnd,
+                      "MultithreadedSimulatorImpl::ScheduleWithContext(): delay "
+                          << delay << " towards node " << context << " is below the lookahead "
+                          << GetLookAhead());
+        target->Post(ts, context, source->GetId(), source->NextSequence(), event);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), Now().GetTimeStep(), 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrentLp()->GetCurrentTs());
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs() - GetCurrentLp()->GetCurrentTs());
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    GetEventLp(id)->Remove(id);
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    return GetEventLp(id)->IsExpired(id);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrentLp()->GetContext();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->GetEventCount();
+    }
+    return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,215 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "logical-process.h"
+
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \defgroup mtp Multithreaded parallel simulation
+ *
+ * Conservative parallel simulation of a single ns-3 process using
+ * shared memory and one thread per topology partition.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ * \ingroup mtp
+ *
+ * \brief Multithreaded simulator implementation using lookahead.
+ *
+ * When Run() is first called, the nodes of NodeList are split into
+ * partitions, one per worker thread.  Point-to-point links with a
+ * non-zero delay may be cut between partitions; nodes sharing any other
+ * kind of channel always end up in the same partition.  The smallest
+ * delay of the cut links is the lookahead.
+ *
+ * The simulation then advances in granted time windows, as in
+ * DistributedSimulatorImpl: every partition runs, in parallel, the
+ * events earlier than the smallest pending timestamp plus the
+ * lookahead.  Events scheduled with ScheduleWithContext() towards a node
+ * of another partition are posted to that partition's mailbox and
+ * received at the start of the next window.
+ *
+ * Events without a node context, such as those scheduled from the main
+ * program before Run(), are kept in a separate logical process which is
+ * executed serially while every worker is idle.
+ *
+ * Models running in different partitions must not share mutable state
+ * other than through ScheduleWithContext().
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Default constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // virtual from SimulatorImpl
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Add additional bound to lookahead constraints.
+     *
+     * \param [in] lookAhead The maximum lookahead; must be > 0.
+     */
+    void BoundLookAhead(const Time lookAhead);
+
+    /** \return The number of node partitions, zero before the first Run(). */
+    uint32_t GetPartitionCount() const;
+
+    /** \return The lookahead used to size the time windows. */
+    Time GetLookAhead() const;
+
+  private:
+    // Inherited from Object
+    void DoDispose() override;
+
+    /**
+     * Assign the nodes to partitions, compute the lookahead, move the
+     * already scheduled node events to their partition and start the
+     * worker threads.
+     */
+    void Partition();
+
+    /**
+     * Get the logical process running on the calling thread.
+     *
+     * \return The logical process, or the one of the nodeless events when
+     *         called outside of a worker.
+     */
+    LogicalProcess* GetCurrentLp() const;
+
+    /**
+     * Get the logical process owning a context.
+     *
+     * \param [in] context The event context.
+     * \return The logical process.
+     */
+    LogicalProcess* GetLp(uint32_t context) const;
+
+    /**
+     * Get the logical process owning an event.
+     *
+     * While the partitions run, the event must belong to the partition
+     * of the calling thread: the queue and clock of another partition
+     * cannot be read safely.
+     *
+     * \param [in] id The event.
+     * eturn The logical process.
+     */
+    LogicalProcess* GetEventLp(const EventId& id) const;
+
+    /**
+     * Main loop of a worker thread.
+     *
+     * \param [in] lp The logical process driven by the thread.
+     */
+    void WorkerLoop(LogicalProcess* lp);
+
+    /**
+     * Run one granted time window on every partition.
+     *
+     * \param [in] windowEnd End of the window (exclusive).
+     */
+    void RunWindow(uint64_t windowEnd);
+
+    /** Stop and join the worker threads. */
+    void StopWorkers();
+
+    /** Container type for the events to run at Simulator::Destroy(). */
+    typedef std::list<EventId> DestroyEvents;
+
+    /** The container of events to run at Destroy() */
+    DestroyEvents m_destroyEvents;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+    /** The scheduler factory, used for every logical process. */
+    ObjectFactory m_schedulerFactory;
+    /** Maximum number of partitions, 0 for the number of hardware threads. */
+    uint32_t m_maxThreads;
+
+    /**
+     * The logical processes.  Index 0 holds the events without a node
+     * context, the others one partition each.
+     */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** Partition index of each node, indexed by node id. */
+    std::vector<uint32_t> m_nodePartition;
+    /** Whether Partition() has run. */
+    bool m_partitioned;
+    /** Lookahead, in time steps. */
+    uint64_t m_lookAhead;
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+
+    std::vector<std::thread> m_workers;    /**< Worker threads, one per extra partition. */
+    std::mutex m_windowMutex;              /**< Protects the window state below. */
+    std::condition_variable m_windowStart; /**< Signals a new window. */
+    std::condition_variable m_windowDone;  /**< Signals the end of a window. */
+    uint64_t m_window;                     /**< Number of the current window. */
+    uint64_t m_windowEnd;                  /**< End of the current window. */
+    uint32_t m_running;                    /**< Workers still in the current window. */
+    bool m_terminate;                      /**< Ask the workers to exit. */
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
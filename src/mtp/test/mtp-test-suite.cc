@@ -0,0 +1,485 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * MultithreadedSimulatorImpl test suite
+ */
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-tests Multithreaded simulator tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Pass tokens along a chain of nodes split over several partitions and
+ * check that every hop runs at the right time, in the right context.
+ */
+class MtpChainTestCase : public TestCase
+{
+  public:
+    MtpChainTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Receive a token and forward it to the next node of the chain.
+     *
+     * \param [in] hop Number of hops already done.
+     * \param [in] expected Expected arrival time.
+     */
+    void Receive(uint32_t hop, Time expected);
+
+    /** Record a failed check, possibly from a worker thread. */
+    void Fail();
+
+    NodeContainer m_nodes; //!< The chain.
+    Time m_delay;          //!< Per hop delay.
+    uint32_t m_hops;       //!< Hops done before a token is dropped.
+    std::mutex m_mutex;    //!< Protects the counters below.
+    uint32_t m_received;   //!< Number of tokens received.
+    uint32_t m_errors;     //!< Number of failed checks.
+    Time m_lastEvent;      //!< Time of the last token arrival.
+};
+
+MtpChainTestCase::MtpChainTestCase()
+    : TestCase("Check cross-partition scheduling along a chain of nodes"),
+      m_delay(MilliSeconds(1)),
+      m_hops(50),
+      m_received(0),
+      m_errors(0)
+{
+}
+
+void
+MtpChainTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(4));
+}
+
+void
+MtpChainTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    Config::Reset();
+}
+
+void
+MtpChainTestCase::Fail()
+{
+    std::unique_lock lock{m_mutex};
+    m_errors++;
+}
+
+void
+MtpChainTestCase::Receive(uint32_t hop, Time expected)
+{
+    if (Simulator::Now() != expected ||
+        Simulator::GetContext() != m_nodes.Get(hop % m_nodes.GetN())->GetId())
+    {
+        Fail();
+    }
+    {
+        std::unique_lock lock{m_mutex};
+        m_received++;
+        m_lastEvent = std::max(m_lastEvent, Simulator::Now());
+    }
+    if (hop + 1 == m_hops)
+    {
+        return;
+    }
+    // Local events stay on the current partition
+    EventId local = Simulator::Schedule(m_delay / 2, &MtpChainTestCase::Fail, this);
+    if (Simulator::IsExpired(local) || Simulator::GetDelayLeft(local) != m_delay / 2)
+    {
+        Fail();
+    }
+    Simulator::Cancel(local);
+
+    uint32_t next = m_nodes.Get((hop + 1) % m_nodes.GetN())->GetId();
+    Simulator::ScheduleWithContext(next,
+                                   m_delay,
+                                   &MtpChainTestCase::Receive,
+                                   this,
+                                   hop + 1,
+                                   Simulator::Now() + m_delay);
+}
+
+void
+MtpChainTestCase::DoRun()
+{
+    // A ring of point-to-point links
+    m_nodes.Create(8);
+    for (uint32_t i = 0; i < m_nodes.GetN(); ++i)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        channel->SetAttribute("Delay", TimeValue(m_delay));
+        for (auto node : {m_nodes.Get(i), m_nodes.Get((i + 1) % m_nodes.GetN())})
+        {
+            Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+            device->SetAttribute("PointToPointMode", BooleanValue(true));
+            device->SetChannel(channel);
+            node->AddDevice(device);
+        }
+    }
+
+    // One token starting from every node, scheduled before partitioning
+    for (uint32_t i = 0; i < m_nodes.GetN(); ++i)
+    {
+        Simulator::ScheduleWithContext(m_nodes.Get(i)->GetId(),
+                                       Seconds(1),
+                                       &MtpChainTestCase::Receive,
+                                       this,
+                                       i,
+                                       Seconds(1));
+    }
+    Simulator::Run();
+
+    auto impl = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Wrong simulator implementation");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), 4, "Wrong number of partitions");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLookAhead(), m_delay, "Wrong lookahead");
+
+    uint32_t tokens = 0;
+    for (uint32_t i = 0; i < m_nodes.GetN(); ++i)
+    {
+        tokens += m_hops - i;
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_errors, 0, "Events ran at the wrong time or in the wrong context");
+    NS_TEST_EXPECT_MSG_EQ(m_received, tokens, "Tokens were lost");
+    NS_TEST_EXPECT_MSG_EQ(m_lastEvent, Seconds(1) + m_delay * (m_hops - 1), "Wrong end time");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), m_lastEvent, "Wrong simulation time after Run");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Send packets both ways along a chain of point-to-point links cut
+ * between partitions, and check that they arrive intact and on time.
+ */
+class MtpPointToPointTestCase : public TestCase
+{
+  public:
+    MtpPointToPointTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Create a packet and send it on a device.
+     *
+     * \param [in] device The sending device.
+     * \param [in] seq The packet sequence number.
+     */
+    void Send(Ptr<NetDevice> device, uint8_t seq);
+
+    /**
+     * Forward a packet along the chain, or record its arrival at the end.
+     *
+     * \param [in] device The receiving device.
+     * \param [in] packet The packet.
+     * \param [in] protocol The protocol number.
+     * \param [in] from The sender address.
+     * \return Always true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    static constexpr uint32_t PAYLOAD_SIZE = 1000; //!< Packet payload size.
+
+    /// The device a packet received on a device is forwarded to, if any.
+    std::map<Ptr<NetDevice>, Ptr<NetDevice>> m_forward;
+    std::mutex m_mutex;          //!< Protects the members below.
+    std::vector<Time> m_arrival; //!< Arrival time of each packet at the end of the chain.
+    uint32_t m_corrupted;        //!< Number of packets received with wrong data.
+};
+
+MtpPointToPointTestCase::MtpPointToPointTestCase()
+    : TestCase("Check packets crossing point-to-point links between partitions"),
+      m_corrupted(0)
+{
+}
+
+void
+MtpPointToPointTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(4));
+}
+
+void
+MtpPointToPointTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    Config::Reset();
+}
+
+void
+MtpPointToPointTestCase::Send(Ptr<NetDevice> device, uint8_t seq)
+{
+    std::vector<uint8_t> payload(PAYLOAD_SIZE, seq);
+    Ptr<Packet> packet = Create<Packet>(payload.data(), payload.size());
+    SocketPriorityTag tag;
+    tag.SetPriority(seq);
+    packet->AddPacketTag(tag);
+    packet->AddByteTag(tag);
+    device->Send(packet, device->GetBroadcast(), 0x0800);
+}
+
+bool
+MtpPointToPointTestCase::Receive(Ptr<NetDevice> device,
+                                 Ptr<const Packet> packet,
+                                 uint16_t protocol,
+                                 const Address& from)
+{
+    Ptr<NetDevice> next = m_forward.at(device);
+    if (next)
+    {
+        next->Send(packet->Copy(), next->GetBroadcast(), protocol);
+        return true;
+    }
+
+    std::vector<uint8_t> payload(packet->GetSize());
+    packet->CopyData(payload.data(), payload.size());
+    uint8_t seq = payload.front();
+    SocketPriorityTag packetTag;
+    SocketPriorityTag byteTag;
+    ByteTagIterator tags = packet->GetByteTagIterator();
+    bool ok = payload.size() == PAYLOAD_SIZE &&
+              std::all_of(payload.begin(), payload.end(), [seq](auto b) { return b == seq; }) &&
+              packet->PeekPacketTag(packetTag) && packetTag.GetPriority() == seq &&
+              tags.HasNext();
+    if (ok)
+    {
+        tags.Next().GetTag(byteTag);
+        ok = byteTag.GetPriority() == seq && !tags.HasNext();
+    }
+
+    std::unique_lock lock{m_mutex};
+    if (!ok || seq >= m_arrival.size())
+    {
+        m_corrupted++;
+        return true;
+    }
+    m_arrival[seq] = Simulator::Now();
+    return true;
+}
+
+void
+MtpPointToPointTestCase::DoRun()
+{
+    const uint32_t nNodes = 8;
+    const uint32_t nPackets = 20;
+    const Time delay = MilliSeconds(1);
+    const Time interval = MilliSeconds(10);
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", TimeValue(delay));
+    std::vector<NetDeviceContainer> links;
+    for (uint32_t i = 0; i + 1 < nNodes; ++i)
+    {
+        links.push_back(p2p.Install(nodes.Get(i), nodes.Get(i + 1)));
+    }
+    // Forward rightwards on the device towards the left neighbour, and the
+    // other way round; the ends of the chain keep what they receive
+    for (uint32_t i = 0; i + 1 < nNodes; ++i)
+    {
+        m_forward[links[i].Get(1)] = i + 2 < nNodes ? links[i + 1].Get(0) : nullptr;
+        m_forward[links[i].Get(0)] = i > 0 ? links[i - 1].Get(1) : nullptr;
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+            links[i].Get(j)->SetReceiveCallback(
+                MakeCallback(&MtpPointToPointTestCase::Receive, this));
+        }
+    }
+
+    // Even packets go rightwards and odd ones leftwards, at the same times
+    m_arrival.resize(nPackets);
+    for (uint8_t seq = 0; seq < nPackets; ++seq)
+    {
+        bool rightwards = seq % 2 == 0;
+        Ptr<NetDevice> device = rightwards ? links.front().Get(0) : links.back().Get(1);
+        Simulator::ScheduleWithContext(device->GetNode()->GetId(),
+                                       interval * (seq / 2),
+                                       &MtpPointToPointTestCase::Send,
+                                       this,
+                                       device,
+                                       seq);
+    }
+    Simulator::Run();
+
+    auto impl = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Wrong simulator implementation");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), 4, "Wrong number of partitions");
+    uint32_t deepCopies = 0;
+    for (const auto& link : links)
+    {
+        BooleanValue deepCopy;
+        link.Get(0)->GetChannel()->GetAttribute("DeepCopy", deepCopy);
+        deepCopies += deepCopy.Get();
+    }
+    NS_TEST_EXPECT_MSG_EQ(deepCopies, 3, "Only the links between partitions copy packets");
+    NS_TEST_EXPECT_MSG_EQ(m_corrupted, 0, "Packets were corrupted");
+
+    // The payload and the PPP header take 8 ns per byte on the wire
+    const Time hop = delay + NanoSeconds(8 * (PAYLOAD_SIZE + 2));
+    for (uint8_t seq = 0; seq < nPackets; ++seq)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_arrival[seq],
+                              interval * (seq / 2) + hop * (nNodes - 1),
+                              "Packet " << +seq << " arrived at the wrong time");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Check that Simulator::Stop interrupts all the partitions at the same time.
+ */
+class MtpStopTestCase : public TestCase
+{
+  public:
+    MtpStopTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Periodic node event.
+     *
+     * \param [in] index Index of the node.
+     */
+    void Tick(uint32_t index);
+
+    std::vector<Time> m_lastTick; //!< Time of the last tick, per node.
+};
+
+MtpStopTestCase::MtpStopTestCase()
+    : TestCase("Check Simulator::Stop with several partitions")
+{
+}
+
+void
+MtpStopTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(2));
+}
+
+void
+MtpStopTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    Config::Reset();
+}
+
+void
+MtpStopTestCase::Tick(uint32_t index)
+{
+    m_lastTick[index] = Simulator::Now();
+    Simulator::Schedule(MilliSeconds(3), &MtpStopTestCase::Tick, this, index);
+}
+
+void
+MtpStopTestCase::DoRun()
+{
+    // Two nodes without any link: they are independent
+    NodeContainer nodes;
+    nodes.Create(2);
+    m_lastTick.resize(nodes.GetN());
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        Simulator::ScheduleWithContext(nodes.Get(i)->GetId(),
+                                       Time(0),
+                                       &MtpStopTestCase::Tick,
+                                       this,
+                                       i);
+    }
+    Simulator::Stop(MilliSeconds(100));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(100), "Wrong stop time");
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_lastTick[i], MilliSeconds(99), "Node ran past the stop time");
+    }
+    // 34 ticks and Node::Initialize per node, and the stop event
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 2 * 35 + 1, "Wrong number of events");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief The MultithreadedSimulatorImpl TestSuite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite()
+        : TestSuite("mtp", Type::UNIT)
+    {
+        AddTestCase(new MtpChainTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new MtpPointToPointTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new MtpStopTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
@@ -54,7 +54,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+NS_THREAD_CACHE uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -79,9 +79,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+NS_THREAD_CACHE uint32_t Buffer::g_maxSize = 0;
+NS_THREAD_CACHE Buffer::FreeList* Buffer::g_freeList = nullptr;
+NS_THREAD_CACHE Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -102,10 +102,10 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
     g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
+    /* feed into free list, if this thread has one: with per-thread free
+     * lists, the data may have been created by another thread */
+    if (data->m_size < g_maxSize || !IS_INITIALIZED(g_freeList) || g_freeList->size() > 1000)
     {
         Buffer::Deallocate(data);
     }
@@ -123,6 +123,9 @@ Buffer::Create(uint32_t dataSize)
     /* try to find a buffer correctly sized. */
     if (IS_UNINITIALIZED(g_freeList))
     {
+        // Touch the destructor, so that a thread_local free list is also
+        // released when its thread exits
+        (void)&g_localStaticDestructor;
         g_freeList = new Buffer::FreeList();
     }
     else if (IS_INITIALIZED(g_freeList))
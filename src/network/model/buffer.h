@@ -20,6 +20,7 @@
 #define BUFFER_H
 
 #include "ns3/assert.h"
+#include "ns3/simulation-local.h"
 
 #include <ostream>
 #include <stdint.h>
@@ -769,7 +770,7 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
-    static uint32_t g_recommendedStart;
+    static NS_THREAD_CACHE uint32_t g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -802,9 +803,10 @@ class Buffer
         ~LocalStaticDestructor();
     };
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    static NS_THREAD_CACHE uint32_t g_maxSize;   //!< Max observed data size
+    static NS_THREAD_CACHE FreeList* g_freeList; //!< Buffer data container
+    /// Local static destructor
+    static NS_THREAD_CACHE LocalStaticDestructor g_localStaticDestructor;
 #endif
 };
 
@@ -19,6 +19,7 @@
 #include "byte-tag-list.h"
 
 #include "ns3/log.h"
+#include "ns3/simulation-local.h"
 
 #include <cstring>
 #include <limits>
@@ -56,13 +57,13 @@ struct ByteTagListData
  *
  * Internal use only.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+static NS_THREAD_CACHE class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
 } g_freeList; //!< Container for struct ByteTagListData
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+static NS_THREAD_CACHE uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
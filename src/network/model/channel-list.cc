@@ -23,6 +23,7 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulation-local.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -130,7 +131,7 @@ Ptr<ChannelListPriv>*
 ChannelListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<ChannelListPriv> ptr = nullptr;
+    static NS_SIMULATION_LOCAL Ptr<ChannelListPriv> ptr = nullptr;
     if (!ptr)
     {
         ptr = CreateObject<ChannelListPriv>();
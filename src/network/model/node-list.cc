@@ -26,6 +26,7 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulation-local.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -133,7 +134,7 @@ Ptr<NodeListPriv>*
 NodeListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<NodeListPriv> ptr = nullptr;
+    static NS_SIMULATION_LOCAL Ptr<NodeListPriv> ptr = nullptr;
     if (!ptr)
     {
         ptr = CreateObject<NodeListPriv>();
@@ -36,10 +36,11 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
-bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+NS_THREAD_CACHE bool PacketMetadata::m_metadataSkipped = false;
+NS_THREAD_CACHE uint32_t PacketMetadata::m_maxSize = 0;
+NS_THREAD_CACHE uint16_t PacketMetadata::m_chunkUid = 0;
+NS_THREAD_CACHE PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+NS_THREAD_CACHE bool PacketMetadata::m_freeListDestroyed = false;
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -48,7 +49,9 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
-    PacketMetadata::m_enable = false;
+    // Recycle() and Create() must not use the list any more; with
+    // per-thread free lists, this does not affect the other threads
+    PacketMetadata::m_freeListDestroyed = true;
 }
 
 void
@@ -572,7 +575,7 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
-    while (!m_freeList.empty())
+    while (!m_freeListDestroyed && !m_freeList.empty())
     {
         PacketMetadata::Data* data = m_freeList.back();
         m_freeList.pop_back();
@@ -593,7 +596,7 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (!m_enable || m_freeListDestroyed)
     {
         PacketMetadata::Deallocate(data);
         return;
@@ -23,6 +23,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/callback.h"
+#include "ns3/simulation-local.h"
 #include "ns3/type-id.h"
 
 #include <limits>
@@ -675,19 +676,21 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static NS_THREAD_CACHE DataFreeList m_freeList; //!< the metadata data storage
+    /// Set once m_freeList has been destroyed, at exit
+    static NS_THREAD_CACHE bool m_freeListDestroyed;
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
      * middle of a simulation, which isn't allowed.
      */
-    static bool m_metadataSkipped;
+    static NS_THREAD_CACHE bool m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
-    static uint16_t m_chunkUid; //!< Chunk Uid
+    static NS_THREAD_CACHE uint32_t m_maxSize;  //!< maximum metadata size
+    static NS_THREAD_CACHE uint16_t m_chunkUid; //!< Chunk Uid
 
     Data* m_data; //!< Metadata storage
     /*
@@ -32,9 +32,14 @@
 #include "ns3/callback.h"
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
+#include "ns3/simulation-local.h"
 
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -459,6 +464,18 @@ class Packet : public SimpleRefCount<Packet>
      */
     Ptr<Packet> Copy() const;
 
+    /**
+     * \brief performs a deep copy of the packet.
+     *
+     * \returns a copy of the packet which shares no data with it.
+     *
+     * The packet is serialized, with its tags, metadata and nix-vector,
+     * and deserialized again, as done by the MPI module, so the copy has
+     * the same uid.  This is much more expensive than Copy(), and only
+     * needed to hand a packet over to another thread.
+     */
+    Ptr<Packet> DeepCopy() const;
+
     /**
      * \brief Returns the packet's Uid.
      *
@@ -795,7 +812,11 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
+    static NS_SIMULATION_LOCAL uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
@@ -35,7 +35,7 @@ NS_LOG_COMPONENT_DEFINE("Mac16Address");
 
 ATTRIBUTE_HELPER_CPP(Mac16Address);
 
-uint64_t Mac16Address::m_allocationIndex = 0;
+NS_SIMULATION_LOCAL uint64_t Mac16Address::m_allocationIndex = 0;
 
 Mac16Address::Mac16Address(const char* str)
 {
@@ -24,6 +24,7 @@
 
 #include "ns3/attribute-helper.h"
 #include "ns3/attribute.h"
+#include "ns3/simulation-local.h"
 
 #include <ostream>
 #include <stdint.h>
@@ -228,8 +229,8 @@ class Mac16Address
      */
     friend std::istream& operator>>(std::istream& is, Mac16Address& address);
 
-    static uint64_t m_allocationIndex; //!< Address allocation index
-    uint8_t m_address[2]{0};           //!< Address value
+    static NS_SIMULATION_LOCAL uint64_t m_allocationIndex; //!< Address allocation index
+    uint8_t m_address[2]{0};                               //!< Address value
 };
 
 ATTRIBUTE_HELPER_HEADER(Mac16Address);
@@ -21,6 +21,7 @@
 #define MAC8_ADDRESS_H
 
 #include "ns3/address.h"
+#include "ns3/simulation-local.h"
 
 #include <iostream>
 
@@ -130,8 +131,8 @@ class Mac8Address
     static void ResetAllocationIndex();
 
   private:
-    static uint8_t m_allocationIndex; //!< Address allocation index
-    uint8_t m_address{255};           //!< The address.
+    static NS_SIMULATION_LOCAL uint8_t m_allocationIndex; //!< Address allocation index
+    uint8_t m_address{255};                               //!< The address.
 
     /**
      * Get the Mac8Address type.
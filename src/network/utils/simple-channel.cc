@@ -20,6 +20,7 @@
 
 #include "simple-net-device.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -45,7 +46,15 @@ SimpleChannel::GetTypeId()
                                           "Transmission delay through the channel",
                                           TimeValue(Seconds(0)),
                                           MakeTimeAccessor(&SimpleChannel::m_delay),
-                                          MakeTimeChecker());
+                                          MakeTimeChecker())
+                            .AddAttribute("DeepCopy",
+                                          "Whether the receiving devices get deep copies of "
+                                          "each packet, sharing no data with the packet sent.  "
+                                          "This is needed when the devices are run by "
+                                          "different threads.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&SimpleChannel::m_deepCopy),
+                                          MakeBooleanChecker());
     return tid;
 }
 
@@ -81,7 +90,7 @@ SimpleChannel::Send(Ptr<Packet> p,
                                        m_delay,
                                        &SimpleNetDevice::Receive,
                                        tmp,
-                                       p->Copy(),
+                                       m_deepCopy ? p->DeepCopy() : p->Copy(),
                                        protocol,
                                        to,
                                        from);
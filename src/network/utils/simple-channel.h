@@ -103,7 +103,8 @@ class SimpleChannel : public Channel
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
   private:
-    Time m_delay; //!< The assigned speed-of-light delay of the channel
+    Time m_delay;    //!< The assigned speed-of-light delay of the channel
+    bool m_deepCopy; //!< Deliver deep copies of the packets
     std::vector<Ptr<SimpleNetDevice>> m_devices; //!< devices connected by the channel
     std::map<Ptr<SimpleNetDevice>, std::vector<Ptr<SimpleNetDevice>>>
         m_blackListedDevices; //!< devices blocked on a device
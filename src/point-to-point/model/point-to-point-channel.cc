@@ -19,6 +19,7 @@
 
 #include "point-to-point-net-device.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -44,6 +45,13 @@ PointToPointChannel::GetTypeId()
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointChannel::m_delay),
                           MakeTimeChecker())
+            .AddAttribute("DeepCopy",
+                          "Whether the receiving device gets a deep copy of each packet, "
+                          "sharing no data with the packet sent.  This is needed when the "
+                          "two ends of the channel are run by different threads.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointChannel::m_deepCopy),
+                          MakeBooleanChecker())
             .AddTraceSource("TxRxPointToPoint",
                             "Trace source indicating transmission of packet "
                             "from the PointToPointChannel, used by the Animation "
@@ -59,6 +67,7 @@ PointToPointChannel::GetTypeId()
 PointToPointChannel::PointToPointChannel()
     : Channel(),
       m_delay(Seconds(0.)),
+      m_deepCopy(false),
       m_nDevices(0)
 {
     NS_LOG_FUNCTION_NOARGS();
@@ -100,7 +109,7 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
                                    txTime + m_delay,
                                    &PointToPointNetDevice::Receive,
                                    m_link[wire].m_dst,
-                                   p->Copy());
+                                   m_deepCopy ? p->DeepCopy() : p->Copy());
 
     // Call the tx anim callback on the net device
     m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
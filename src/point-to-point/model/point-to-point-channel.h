@@ -152,6 +152,7 @@ class PointToPointChannel : public Channel
     static const std::size_t N_DEVICES = 2;
 
     Time m_delay;           //!< Propagation delay
+    bool m_deepCopy;        //!< Deliver deep copies of the packets
     std::size_t m_nDevices; //!< Devices of this channel
 
     /**
@@ -709,7 +709,7 @@ QueueDisc::PacketDequeued(Ptr<const QueueDiscItem> item)
         m_stats.nTotalDequeuedPackets++;
         m_stats.nTotalDequeuedBytes += item->GetSize();
 
-        m_sojourn(Simulator::Now() - item->GetTimeStamp());
+        NS_HOT_TRACE(m_sojourn, Simulator::Now() - item->GetTimeStamp());
 
         NS_LOG_LOGIC("m_traceDequeue (p)");
         m_traceDequeue(item);
@@ -1057,7 +1057,7 @@ QueueDisc::Requeue(Ptr<QueueDiscItem> item)
     m_stats.nTotalRequeuedBytes += item->GetSize();
 
     NS_LOG_LOGIC("m_traceRequeue (p)");
-    m_traceRequeue(item);
+    NS_HOT_TRACE(m_traceRequeue, item);
 }
 
 bool
@@ -221,6 +221,18 @@ VisualSimulatorImpl::GetEventCount() const
     return m_simulator->GetEventCount();
 }
 
+uint64_t
+VisualSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_simulator->GetCancelledEventCount();
+}
+
+uint64_t
+VisualSimulatorImpl::GetPurgedEventCount() const
+{
+    return m_simulator->GetPurgedEventCount();
+}
+
 void
 VisualSimulatorImpl::RunRealSimulator()
 {
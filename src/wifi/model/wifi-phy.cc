@@ -1564,7 +1564,7 @@ WifiPhy::GetMaxPsduSize(WifiModulationClass modulation)
 void
 WifiPhy::NotifyTxBegin(WifiConstPsduMap psdus, double txPowerW)
 {
-    if (!m_phyTxBeginTrace.IsEmpty())
+    if (NS_HOT_TRACE_CONNECTED(m_phyTxBeginTrace))
     {
         for (const auto& psdu : psdus)
         {
@@ -1579,7 +1579,7 @@ WifiPhy::NotifyTxBegin(WifiConstPsduMap psdus, double txPowerW)
 void
 WifiPhy::NotifyTxEnd(WifiConstPsduMap psdus)
 {
-    if (!m_phyTxEndTrace.IsEmpty())
+    if (NS_HOT_TRACE_CONNECTED(m_phyTxEndTrace))
     {
         for (const auto& psdu : psdus)
         {
@@ -1594,7 +1594,7 @@ WifiPhy::NotifyTxEnd(WifiConstPsduMap psdus)
 void
 WifiPhy::NotifyTxDrop(Ptr<const WifiPsdu> psdu)
 {
-    if (!m_phyTxDropTrace.IsEmpty())
+    if (NS_HOT_TRACE_CONNECTED(m_phyTxDropTrace))
     {
         for (auto& mpdu : *PeekPointer(psdu))
         {
@@ -1606,7 +1606,7 @@ WifiPhy::NotifyTxDrop(Ptr<const WifiPsdu> psdu)
 void
 WifiPhy::NotifyRxBegin(Ptr<const WifiPsdu> psdu, const RxPowerWattPerChannelBand& rxPowersW)
 {
-    if (psdu && !m_phyRxBeginTrace.IsEmpty())
+    if (psdu && NS_HOT_TRACE_CONNECTED(m_phyRxBeginTrace))
     {
         for (auto& mpdu : *PeekPointer(psdu))
         {
@@ -1618,7 +1618,7 @@ WifiPhy::NotifyRxBegin(Ptr<const WifiPsdu> psdu, const RxPowerWattPerChannelBand
 void
 WifiPhy::NotifyRxEnd(Ptr<const WifiPsdu> psdu)
 {
-    if (psdu && !m_phyRxEndTrace.IsEmpty())
+    if (psdu && NS_HOT_TRACE_CONNECTED(m_phyRxEndTrace))
     {
         for (auto& mpdu : *PeekPointer(psdu))
         {
@@ -1630,7 +1630,7 @@ WifiPhy::NotifyRxEnd(Ptr<const WifiPsdu> psdu)
 void
 WifiPhy::NotifyRxDrop(Ptr<const WifiPsdu> psdu, WifiPhyRxfailureReason reason)
 {
-    if (psdu && !m_phyRxDropTrace.IsEmpty())
+    if (psdu && NS_HOT_TRACE_CONNECTED(m_phyRxDropTrace))
     {
         for (auto& mpdu : *PeekPointer(psdu))
         {
@@ -387,24 +387,89 @@ BenchSuite::Log() const
 
 } // BenchSuite::Log()
 
+/**
+ *  Mixture of short, PHY-like delays and long, timer-like delays.
+ *
+ *  Most delays are drawn from an exponential distribution with a mean
+ *  of a few ns; the others are uniform over several seconds.  In steady
+ *  state the scheduler then holds a dense cluster of near events and a
+ *  sparse cloud of far events, which defeats fixed-width bucket schemes.
+ */
+class BimodalRandomVariable : public RandomVariableStream
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] shortMean The mean of the short delays, in ns.
+     * \param [in] longMin The smallest long delay, in ns.
+     * \param [in] longMax The largest long delay, in ns.
+     * \param [in] longFraction The probability of a long delay.
+     */
+    BimodalRandomVariable(double shortMean, double longMin, double longMax, double longFraction)
+        : m_longFraction(longFraction)
+    {
+        m_choice = CreateObject<UniformRandomVariable>();
+        m_short = CreateObject<ExponentialRandomVariable>();
+        m_short->SetAttribute("Mean", DoubleValue(shortMean));
+        m_long = CreateObject<UniformRandomVariable>();
+        m_long->SetAttribute("Min", DoubleValue(longMin));
+        m_long->SetAttribute("Max", DoubleValue(longMax));
+    }
+
+    double GetValue() override
+    {
+        if (m_choice->GetValue() < m_longFraction)
+        {
+            return m_long->GetValue();
+        }
+        return m_short->GetValue();
+    }
+
+  private:
+    Ptr<UniformRandomVariable> m_choice;    /**< Selects the mode. */
+    Ptr<ExponentialRandomVariable> m_short; /**< Short delays. */
+    Ptr<UniformRandomVariable> m_long;      /**< Long delays. */
+    double m_longFraction;                  /**< Probability of a long delay. */
+
+}; // class BimodalRandomVariable
+
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
- *  If the \p filename parameter is empty a default exponential time
- *  distribution will be used, with mean delay of 100 ns.
+ *  If the \p filename parameter is empty the \p dist distribution will
+ *  be used:
+ *  - \c exp: exponential, with mean delay of 100 ns (the default);
+ *  - \c bimodal: 99% exponential with mean 10 ns, 1% uniform in [1, 10] s;
+ *  - \c pareto: Pareto, with scale 10 ns and shape 1.2 (mean 60 ns).
  *
  *  If the \p filename is `-` standard input will be used.
  *
  *  \param [in] filename The delay interval source file name.
+ *  \param [in] dist The delay distribution, if no \p filename is given.
  *  \returns The RandomVariableStream.
  */
 Ptr<RandomVariableStream>
-GetRandomStream(std::string filename)
+GetRandomStream(std::string filename, std::string dist)
 {
     Ptr<RandomVariableStream> stream = nullptr;
 
-    if (filename.empty())
+    if (filename.empty() && dist == "bimodal")
     {
+        LOG("  Event time distribution:      bimodal");
+        stream = CreateObject<BimodalRandomVariable>(10, 1e9, 10e9, 0.01);
+    }
+    else if (filename.empty() && dist == "pareto")
+    {
+        LOG("  Event time distribution:      pareto");
+        auto prv = CreateObject<ParetoRandomVariable>();
+        prv->SetAttribute("Scale", DoubleValue(10));
+        prv->SetAttribute("Shape", DoubleValue(1.2));
+        stream = prv;
+    }
+    else if (filename.empty())
+    {
+        NS_ABORT_MSG_UNLESS(dist == "exp", "Unknown distribution " << dist);
         LOG("  Event time distribution:      default exponential");
         auto erv = CreateObject<ExponentialRandomVariable>();
         erv->SetAttribute("Mean", DoubleValue(100));
@@ -457,6 +522,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -465,6 +531,7 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string dist = "exp";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -472,6 +539,7 @@ main(int argc, char* argv[])
               "\n"
               "Event intervals are taken from one of:\n"
               "  an exponential distribution, with mean 100 ns,\n"
+              "  a bimodal or a Pareto distribution, given by --dist,\n"
               "  an ascii file, given by the --file=\"<filename>\" argument,\n"
               "  or standard input, by the argument --file=\"-\"\n"
               "In the case of either --file form, the input is expected\n"
@@ -482,6 +550,7 @@ main(int argc, char* argv[])
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -490,6 +559,7 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("dist", "event time distribution: exp, bimodal or pareto", dist);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -505,15 +575,15 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream = GetRandomStream(filename, dist);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -532,6 +602,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
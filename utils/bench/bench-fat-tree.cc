@@ -0,0 +1,150 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup bench
+ * Macro-benchmark: k-ary fat tree of point-to-point links carrying TCP.
+ *
+ * The topology has k pods of k/2 edge and k/2 aggregation switches,
+ * (k/2)^2 core switches and k^3/4 hosts.  Every switch is an IPv4 router
+ * using global routing with random ECMP.  Host i runs a bulk TCP transfer
+ * to host (i + hosts/2) mod hosts, so that every flow crosses the core.
+ */
+
+#include "bench-report.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t k = 8;
+    double simTime = 1;
+    std::string rate = "1Gbps";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("k", "Fat tree arity (even)", k);
+    cmd.AddValue("simTime", "Simulated time, in seconds", simTime);
+    cmd.AddValue("rate", "Link data rate", rate);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(k < 2 || k % 2, "k must be even and at least 2");
+
+    BenchReport report("fat-tree");
+    report.AddParameter("k", k);
+    report.AddParameter("simTime", simTime);
+    report.AddParameter("rate", rate);
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    Config::SetDefault("ns3::Ipv4GlobalRouting::RandomEcmpRouting", BooleanValue(true));
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+
+    const uint32_t half = k / 2;
+    const uint32_t nHosts = k * half * half;
+
+    NodeContainer core;
+    NodeContainer agg;
+    NodeContainer edge;
+    NodeContainer hosts;
+    core.Create(half * half);
+    agg.Create(k * half);
+    edge.Create(k * half);
+    hosts.Create(nHosts);
+
+    InternetStackHelper stack;
+    stack.Install(core);
+    stack.Install(agg);
+    stack.Install(edge);
+    stack.Install(hosts);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue(rate));
+    p2p.SetChannelAttribute("Delay", StringValue("2us"));
+
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.252");
+    std::vector<Ipv4Address> hostAddresses;
+    auto connect = [&](Ptr<Node> a, Ptr<Node> b) {
+        Ipv4InterfaceContainer ifaces = address.Assign(p2p.Install(a, b));
+        address.NewNetwork();
+        return ifaces;
+    };
+
+    for (uint32_t pod = 0; pod < k; ++pod)
+    {
+        for (uint32_t e = 0; e < half; ++e)
+        {
+            Ptr<Node> edgeSwitch = edge.Get(pod * half + e);
+            for (uint32_t h = 0; h < half; ++h)
+            {
+                Ptr<Node> host = hosts.Get((pod * half + e) * half + h);
+                hostAddresses.push_back(connect(host, edgeSwitch).GetAddress(0));
+            }
+            for (uint32_t a = 0; a < half; ++a)
+            {
+                connect(edgeSwitch, agg.Get(pod * half + a));
+            }
+        }
+        for (uint32_t a = 0; a < half; ++a)
+        {
+            for (uint32_t c = 0; c < half; ++c)
+            {
+                connect(agg.Get(pod * half + a), core.Get(a * half + c));
+            }
+        }
+    }
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    const uint16_t port = 5000;
+    PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinks = sinkHelper.Install(hosts);
+    sinks.Start(Seconds(0));
+
+    ApplicationContainer sources;
+    for (uint32_t i = 0; i < nHosts; ++i)
+    {
+        uint32_t dst = (i + nHosts / 2) % nHosts;
+        BulkSendHelper source("ns3::TcpSocketFactory", InetSocketAddress(hostAddresses[dst], port));
+        source.SetAttribute("MaxBytes", UintegerValue(0));
+        sources.Add(source.Install(hosts.Get(i)));
+    }
+    sources.Start(MilliSeconds(1));
+
+    Simulator::Stop(Seconds(simTime));
+    report.StartRun();
+    Simulator::Run();
+    report.StopRun();
+
+    uint64_t rx = 0;
+    for (uint32_t i = 0; i < sinks.GetN(); ++i)
+    {
+        rx += DynamicCast<PacketSink>(sinks.Get(i))->GetTotalRx();
+    }
+    report.AddMetric("nodes", NodeList::GetNNodes());
+    report.AddMetric("rx_bytes", rx);
+    Simulator::Destroy();
+
+    report.Print();
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup bench
+ * Macro-benchmark: global routing over a large network.
+ *
+ * Routers form a binary tree of point-to-point links, and each router
+ * serves a CSMA LAN of hosts.  The tree keeps a single shortest path
+ * between any two routers, which the route computation requires.  The whole network is routed with
+ * Ipv4GlobalRoutingHelper::PopulateRoutingTables(), whose duration is
+ * reported separately, and then a set of UDP flows between random hosts
+ * exercises the resulting forwarding tables.
+ */
+
+#include "bench-report.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nNodes = 10000;
+    uint32_t lanSize = 49;
+    uint32_t nFlows = 100;
+    double simTime = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "Total number of nodes (routers and hosts)", nNodes);
+    cmd.AddValue("lanSize", "Number of hosts on the LAN of each router", lanSize);
+    cmd.AddValue("flows", "Number of UDP flows between random hosts", nFlows);
+    cmd.AddValue("simTime", "Simulated time, in seconds", simTime);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(lanSize == 0 || nNodes < 2 * (lanSize + 1), "Not enough nodes for two LANs");
+
+    BenchReport report("global-routing");
+    report.AddParameter("nodes", nNodes);
+    report.AddParameter("lanSize", lanSize);
+    report.AddParameter("flows", nFlows);
+    report.AddParameter("simTime", simTime);
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    const uint32_t nRouters = nNodes / (lanSize + 1);
+
+    NodeContainer routers;
+    routers.Create(nRouters);
+    std::vector<NodeContainer> lans(nRouters);
+    NodeContainer hosts;
+    InternetStackHelper stack;
+    stack.Install(routers);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    Ipv4AddressHelper coreAddress("172.16.0.0", "255.255.255.252");
+    for (uint32_t r = 1; r < nRouters; ++r)
+    {
+        coreAddress.Assign(p2p.Install(routers.Get((r - 1) / 2), routers.Get(r)));
+        coreAddress.NewNetwork();
+    }
+
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", StringValue("1Gbps"));
+    csma.SetChannelAttribute("Delay", StringValue("1us"));
+    Ipv4AddressHelper lanAddress("10.0.0.0", "255.255.255.0");
+    std::vector<Ipv4Address> hostAddresses;
+    for (uint32_t r = 0; r < nRouters; ++r)
+    {
+        lans[r].Create(lanSize);
+        hosts.Add(lans[r]);
+        stack.Install(lans[r]);
+        NodeContainer segment(routers.Get(r));
+        segment.Add(lans[r]);
+        Ipv4InterfaceContainer ifaces = lanAddress.Assign(csma.Install(segment));
+        lanAddress.NewNetwork();
+        for (uint32_t h = 1; h < ifaces.GetN(); ++h)
+        {
+            hostAddresses.push_back(ifaces.GetAddress(h));
+        }
+    }
+
+    auto routingStart = std::chrono::steady_clock::now();
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    std::chrono::duration<double> routingTime = std::chrono::steady_clock::now() - routingStart;
+
+    const uint16_t port = 9;
+    ApplicationContainer servers = UdpServerHelper(port).Install(hosts);
+    servers.Start(Seconds(0));
+
+    Ptr<UniformRandomVariable> pick = CreateObject<UniformRandomVariable>();
+    pick->SetStream(1);
+    ApplicationContainer clients;
+    for (uint32_t f = 0; f < nFlows; ++f)
+    {
+        uint32_t src = pick->GetInteger(0, hosts.GetN() - 1);
+        uint32_t dst = pick->GetInteger(0, hosts.GetN() - 1);
+        UdpClientHelper client(hostAddresses[dst], port);
+        client.SetAttribute("Interval", TimeValue(MicroSeconds(100)));
+        client.SetAttribute("MaxPackets", UintegerValue(0));
+        clients.Add(client.Install(hosts.Get(src)));
+    }
+    clients.Start(MilliSeconds(10));
+
+    Simulator::Stop(Seconds(simTime));
+    report.StartRun();
+    Simulator::Run();
+    report.StopRun();
+
+    uint64_t received = 0;
+    for (uint32_t i = 0; i < servers.GetN(); ++i)
+    {
+        received += DynamicCast<UdpServer>(servers.Get(i))->GetReceived();
+    }
+    report.AddMetric("nodes", NodeList::GetNNodes());
+    report.AddMetric("routing_time_s", routingTime.count());
+    report.AddMetric("rx_packets", received);
+    Simulator::Destroy();
+
+    report.Print();
+    return 0;
+}
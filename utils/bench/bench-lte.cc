@@ -0,0 +1,170 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup bench
+ * Macro-benchmark: LTE multi-cell scenario with an EPC.
+ *
+ * A row of eNBs, each serving a number of UEs dropped uniformly in its
+ * cell.  A remote host behind the PGW sends downlink UDP traffic to every
+ * UE and every UE sends uplink UDP traffic back, so that the schedulers,
+ * RLC/PDCP and the inter-cell interference computation all run.
+ */
+
+#include "bench-report.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nEnbs = 7;
+    uint32_t nUesPerEnb = 10;
+    double simTime = 1;
+    double distance = 500; // m
+    double interval = 1;   // ms
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nEnbs", "Number of eNBs", nEnbs);
+    cmd.AddValue("nUesPerEnb", "Number of UEs attached to each eNB", nUesPerEnb);
+    cmd.AddValue("simTime", "Simulated time, in seconds", simTime);
+    cmd.AddValue("distance", "Distance between eNBs, in meters", distance);
+    cmd.AddValue("interval", "Packet interval of every flow, in milliseconds", interval);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(nEnbs == 0 || nUesPerEnb == 0, "Invalid scenario");
+
+    BenchReport report("lte");
+    report.AddParameter("nEnbs", nEnbs);
+    report.AddParameter("nUesPerEnb", nUesPerEnb);
+    report.AddParameter("simTime", simTime);
+    report.AddParameter("distance", distance);
+    report.AddParameter("interval", interval);
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper>();
+    lteHelper->SetEpcHelper(epcHelper);
+
+    NodeContainer remoteHostContainer;
+    remoteHostContainer.Create(1);
+    Ptr<Node> remoteHost = remoteHostContainer.Get(0);
+    InternetStackHelper internet;
+    internet.Install(remoteHostContainer);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+    p2p.SetDeviceAttribute("Mtu", UintegerValue(1500));
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    NetDeviceContainer internetDevices = p2p.Install(epcHelper->GetPgwNode(), remoteHost);
+    Ipv4AddressHelper ipv4h("1.0.0.0", "255.0.0.0");
+    Ipv4InterfaceContainer internetIfaces = ipv4h.Assign(internetDevices);
+    Ipv4Address remoteHostAddr = internetIfaces.GetAddress(1);
+
+    Ipv4StaticRoutingHelper routingHelper;
+    routingHelper.GetStaticRouting(remoteHost->GetObject<Ipv4>())
+        ->AddNetworkRouteTo(Ipv4Address("7.0.0.0"), Ipv4Mask("255.0.0.0"), 1);
+
+    NodeContainer enbNodes;
+    enbNodes.Create(nEnbs);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(distance),
+                                  "GridWidth",
+                                  UintegerValue(nEnbs));
+    mobility.Install(enbNodes);
+    NetDeviceContainer enbDevices = lteHelper->InstallEnbDevice(enbNodes);
+
+    NodeContainer ueNodes;
+    std::vector<NetDeviceContainer> ueDevices;
+    for (uint32_t i = 0; i < nEnbs; ++i)
+    {
+        NodeContainer cellUes;
+        cellUes.Create(nUesPerEnb);
+        ueNodes.Add(cellUes);
+        mobility.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                      "X",
+                                      DoubleValue(i * distance),
+                                      "rho",
+                                      DoubleValue(distance / 2));
+        mobility.Install(cellUes);
+        ueDevices.push_back(lteHelper->InstallUeDevice(cellUes));
+    }
+
+    internet.Install(ueNodes);
+    for (uint32_t i = 0; i < nEnbs; ++i)
+    {
+        epcHelper->AssignUeIpv4Address(ueDevices[i]);
+        lteHelper->Attach(ueDevices[i], enbDevices.Get(i));
+    }
+    lteHelper->AssignStreams(enbDevices, 100);
+
+    const uint16_t dlPort = 1000;
+    const uint16_t ulPort = 2000;
+    ApplicationContainer servers;
+    ApplicationContainer clients;
+    servers.Add(UdpServerHelper(ulPort).Install(remoteHost));
+    for (uint32_t u = 0; u < ueNodes.GetN(); ++u)
+    {
+        Ptr<Node> ue = ueNodes.Get(u);
+        Ptr<Ipv4> ipv4 = ue->GetObject<Ipv4>();
+        routingHelper.GetStaticRouting(ipv4)->SetDefaultRoute(
+            epcHelper->GetUeDefaultGatewayAddress(),
+            1);
+        servers.Add(UdpServerHelper(dlPort).Install(ue));
+
+        UdpClientHelper dlClient(ipv4->GetAddress(1, 0).GetLocal(), dlPort);
+        dlClient.SetAttribute("Interval", TimeValue(MilliSeconds(interval)));
+        dlClient.SetAttribute("MaxPackets", UintegerValue(0));
+        clients.Add(dlClient.Install(remoteHost));
+
+        UdpClientHelper ulClient(remoteHostAddr, ulPort);
+        ulClient.SetAttribute("Interval", TimeValue(MilliSeconds(interval)));
+        ulClient.SetAttribute("MaxPackets", UintegerValue(0));
+        clients.Add(ulClient.Install(ue));
+    }
+    servers.Start(MilliSeconds(100));
+    clients.Start(MilliSeconds(100));
+
+    Simulator::Stop(Seconds(simTime));
+    report.StartRun();
+    Simulator::Run();
+    report.StopRun();
+
+    uint64_t received = 0;
+    for (uint32_t i = 0; i < servers.GetN(); ++i)
+    {
+        received += DynamicCast<UdpServer>(servers.Get(i))->GetReceived();
+    }
+    report.AddMetric("nodes", NodeList::GetNNodes());
+    report.AddMetric("rx_packets", received);
+    Simulator::Destroy();
+
+    report.Print();
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include "ns3/simulator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef __WIN32__
+#include <sys/resource.h>
+#endif
+
+/**
+ * \file
+ * \ingroup bench
+ * Machine-readable result reporting shared by the macro-benchmarks.
+ */
+
+/**
+ * \defgroup bench Macro-benchmarks
+ *
+ * Reproducible, whole-simulation benchmarks built by the \c bench target.
+ * Each program prints a single JSON object describing one run.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup bench
+ *
+ * Collects the timings of one benchmark run and prints them as JSON.
+ *
+ * The wall clock starts when the report is constructed, so it should be
+ * created before the scenario is built.  StartRun() marks the end of the
+ * setup phase and StopRun() the end of Simulator::Run().
+ */
+class BenchReport
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] name The benchmark name.
+     */
+    BenchReport(const std::string& name)
+        : m_name(name),
+          m_start(Clock::now()),
+          m_runStart(m_start),
+          m_runStop(m_start)
+    {
+    }
+
+    /**
+     * Record an input parameter of the run.
+     * \param [in] key The parameter name.
+     * \param [in] value The parameter value.
+     */
+    void AddParameter(const std::string& key, uint64_t value)
+    {
+        m_parameters.emplace_back(key, std::to_string(value));
+    }
+
+    /**
+     * \copydoc AddParameter(const std::string&,uint64_t)
+     */
+    void AddParameter(const std::string& key, uint32_t value)
+    {
+        m_parameters.emplace_back(key, std::to_string(value));
+    }
+
+    /**
+     * \copydoc AddParameter(const std::string&,uint64_t)
+     */
+    void AddParameter(const std::string& key, double value)
+    {
+        m_parameters.emplace_back(key, FormatDouble(value));
+    }
+
+    /**
+     * \copydoc AddParameter(const std::string&,uint64_t)
+     */
+    void AddParameter(const std::string& key, const std::string& value)
+    {
+        m_parameters.emplace_back(key, Quote(value));
+    }
+
+    /**
+     * Record a scenario-specific output, such as the delivered throughput,
+     * useful to check that two runs simulated the same thing.
+     * \param [in] key The metric name.
+     * \param [in] value The metric value.
+     */
+    void AddMetric(const std::string& key, double value)
+    {
+        m_metrics.emplace_back(key, FormatDouble(value));
+    }
+
+    /** Mark the end of the setup phase. */
+    void StartRun()
+    {
+        m_runStart = Clock::now();
+        m_eventsBefore = Simulator::GetEventCount();
+    }
+
+    /** Mark the end of Simulator::Run(). */
+    void StopRun()
+    {
+        m_runStop = Clock::now();
+        m_events = Simulator::GetEventCount() - m_eventsBefore;
+        m_simTime = Simulator::Now().GetSeconds();
+    }
+
+    /**
+     * Print the report as a single-line JSON object.
+     * \param [in] os The output stream.
+     */
+    void Print(std::ostream& os = std::cout) const
+    {
+        double setup = Seconds(m_runStart - m_start);
+        double run = Seconds(m_runStop - m_runStart);
+        os << "{\"benchmark\": " << Quote(m_name) << ", \"parameters\": {";
+        PrintPairs(os, m_parameters);
+        os << "}, \"events\": " << m_events << ", \"sim_time_s\": " << FormatDouble(m_simTime)
+           << ", \"setup_time_s\": " << FormatDouble(setup)
+           << ", \"wall_time_s\": " << FormatDouble(run)
+           << ", \"events_per_s\": " << FormatDouble(run > 0 ? m_events / run : 0)
+           << ", \"peak_rss_kb\": " << GetPeakRssKb() << ", \"metrics\": {";
+        PrintPairs(os, m_metrics);
+        os << "}}" << std::endl;
+    }
+
+    /**
+     * Get the peak resident set size of the process.
+     * \return The peak RSS in KiB, or 0 where it is not available.
+     */
+    static uint64_t GetPeakRssKb()
+    {
+#ifdef __WIN32__
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+  private:
+    /** Clock used for all wall time measurements. */
+    using Clock = std::chrono::steady_clock;
+    /** List of preformatted JSON key/value pairs. */
+    using Pairs = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Convert a clock duration to seconds.
+     * \param [in] d The duration.
+     * \return The duration in seconds.
+     */
+    static double Seconds(Clock::duration d)
+    {
+        return std::chrono::duration<double>(d).count();
+    }
+
+    /**
+     * Format a floating point value as a JSON number.
+     * \param [in] v The value.
+     * \return The formatted value.
+     */
+    static std::string FormatDouble(double v)
+    {
+        std::ostringstream oss;
+        oss << std::setprecision(9) << v;
+        return oss.str();
+    }
+
+    /**
+     * Quote a string as a JSON string literal.
+     * \param [in] s The string.
+     * \return The quoted string.
+     */
+    static std::string Quote(const std::string& s)
+    {
+        std::string out = "\"";
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    /**
+     * Print a list of key/value pairs as JSON object members.
+     * \param [in] os The output stream.
+     * \param [in] pairs The pairs.
+     */
+    static void PrintPairs(std::ostream& os, const Pairs& pairs)
+    {
+        for (std::size_t i = 0; i < pairs.size(); ++i)
+        {
+            os << (i ? ", " : "") << Quote(pairs[i].first) << ": " << pairs[i].second;
+        }
+    }
+
+    std::string m_name;           //!< Benchmark name
+    Pairs m_parameters;           //!< Input parameters
+    Pairs m_metrics;              //!< Scenario-specific outputs
+    Clock::time_point m_start;    //!< Time the report was created
+    Clock::time_point m_runStart; //!< Time Simulator::Run() was entered
+    Clock::time_point m_runStop;  //!< Time Simulator::Run() returned
+    uint64_t m_eventsBefore{0};   //!< Events executed before StartRun()
+    uint64_t m_events{0};         //!< Events executed by Simulator::Run()
+    double m_simTime{0};          //!< Simulated time reached, in seconds
+};
+
+} // namespace ns3
+
+#endif /* BENCH_REPORT_H */
@@ -0,0 +1,133 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup bench
+ * Macro-benchmark: a dense 802.11ax BSS.
+ *
+ * One access point and many stations share an 80 MHz channel in the
+ * 5 GHz band.  Every station sends UDP traffic to the access point, and
+ * the aggregate offered load exceeds the channel capacity so that the
+ * channel access, aggregation and block ack machinery stays busy.
+ */
+
+#include "bench-report.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nStations = 64;
+    double simTime = 2;
+    double offeredLoad = 800; // Mbps
+    uint32_t payloadSize = 1400;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nStations", "Number of stations", nStations);
+    cmd.AddValue("simTime", "Simulated time, in seconds", simTime);
+    cmd.AddValue("offeredLoad", "Aggregate offered load, in Mbps", offeredLoad);
+    cmd.AddValue("payloadSize", "UDP payload size, in bytes", payloadSize);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(nStations == 0 || offeredLoad <= 0, "Invalid scenario");
+
+    BenchReport report("wifi-bss");
+    report.AddParameter("nStations", nStations);
+    report.AddParameter("simTime", simTime);
+    report.AddParameter("offeredLoad", offeredLoad);
+    report.AddParameter("payloadSize", payloadSize);
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer staNodes;
+    staNodes.Create(nStations);
+    NodeContainer apNode;
+    apNode.Create(1);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("HeMcs7"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate24Mbps"));
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{0, 80, BAND_5GHZ, 0}"));
+
+    Ssid ssid("bench-bss");
+    WifiMacHelper mac;
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes);
+    mac.SetType("ns3::ApWifiMac", "EnableBeaconJitter", BooleanValue(false), "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
+
+    int64_t stream = 100;
+    stream += wifi.AssignStreams(apDevice, stream);
+    wifi.AssignStreams(staDevices, stream);
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                  "rho",
+                                  DoubleValue(10));
+    mobility.Install(staNodes);
+
+    InternetStackHelper stack;
+    stack.Install(apNode);
+    stack.Install(staNodes);
+    Ipv4AddressHelper address("192.168.0.0", "255.255.0.0");
+    Ipv4InterfaceContainer apInterface = address.Assign(apDevice);
+    address.Assign(staDevices);
+
+    const uint16_t port = 9;
+    UdpServerHelper server(port);
+    ApplicationContainer serverApp = server.Install(apNode);
+    serverApp.Start(Seconds(0));
+
+    double perStationBps = offeredLoad * 1e6 / nStations;
+    UdpClientHelper client(apInterface.GetAddress(0), port);
+    client.SetAttribute("MaxPackets", UintegerValue(0));
+    client.SetAttribute("Interval", TimeValue(Seconds(payloadSize * 8 / perStationBps)));
+    client.SetAttribute("PacketSize", UintegerValue(payloadSize));
+    ApplicationContainer clientApps = client.Install(staNodes);
+    clientApps.Start(MilliSeconds(100));
+
+    Simulator::Stop(Seconds(simTime));
+    report.StartRun();
+    Simulator::Run();
+    report.StopRun();
+
+    uint64_t received = DynamicCast<UdpServer>(serverApp.Get(0))->GetReceived();
+    report.AddMetric("rx_packets", received);
+    report.AddMetric("throughput_mbps", received * payloadSize * 8 / (simTime - 0.1) / 1e6);
+    Simulator::Destroy();
+
+    report.Print();
+    return 0;
+}
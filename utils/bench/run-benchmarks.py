@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Run the ns-3 macro-benchmarks and collect their JSON reports.
+
+Each benchmark program prints one JSON object per run.  This script runs
+every benchmark found in the build directory (or the ones selected with
+--only), optionally several times, and writes all the reports as a JSON
+array.  With --baseline, the events/s of each benchmark are compared
+against a previous result file and the ratio is printed.
+"""
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+
+BENCHMARKS = ["fat-tree", "wifi-bss", "lte", "global-routing"]
+
+# Arguments making every benchmark finish in a few seconds, for smoke tests
+QUICK_ARGS = {
+    "fat-tree": ["--k=4", "--simTime=0.05"],
+    "wifi-bss": ["--nStations=8", "--simTime=0.3"],
+    "lte": ["--nEnbs=2", "--nUesPerEnb=2", "--simTime=0.3"],
+    "global-routing": ["--nodes=200", "--lanSize=9", "--flows=10", "--simTime=0.1"],
+}
+
+
+def find_program(build_dir, name):
+    """Return the path of the benchmark executable, or None if not built."""
+    candidates = glob.glob(
+        os.path.join(build_dir, "utils", "bench", "ns3*-bench-%s*" % name)
+    )
+    candidates = [c for c in candidates if os.access(c, os.X_OK)]
+    if not candidates:
+        return None
+    # Prefer the most recently built profile
+    return max(candidates, key=os.path.getmtime)
+
+
+def run(program, args):
+    """Run one benchmark and return its parsed report."""
+    output = subprocess.check_output([program] + args, universal_newlines=True)
+    for line in reversed(output.splitlines()):
+        line = line.strip()
+        if line.startswith("{"):
+            return json.loads(line)
+    raise RuntimeError("%s did not print a report" % program)
+
+
+def main():
+    source_dir = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "--build-dir",
+        default=os.path.join(source_dir, "build"),
+        help="ns-3 output directory (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--only", action="append", choices=BENCHMARKS, help="benchmark to run"
+    )
+    parser.add_argument("--repeat", type=int, default=1, help="runs per benchmark")
+    parser.add_argument(
+        "--quick", action="store_true", help="use small scenarios, for smoke tests"
+    )
+    parser.add_argument("--output", help="file to write the JSON results to")
+    parser.add_argument("--baseline", help="JSON results to compare against")
+    options = parser.parse_args()
+
+    results = []
+    for name in options.only or BENCHMARKS:
+        program = find_program(options.build_dir, name)
+        if program is None:
+            print("skipping %s: not built" % name, file=sys.stderr)
+            continue
+        args = QUICK_ARGS[name] if options.quick else []
+        for _ in range(options.repeat):
+            report = run(program, args)
+            print(json.dumps(report))
+            results.append(report)
+
+    if options.output:
+        with open(options.output, "w", encoding="utf-8") as f:
+            json.dump(results, f, indent=2)
+
+    if options.baseline:
+        with open(options.baseline, encoding="utf-8") as f:
+            baseline = json.load(f)
+        for name in options.only or BENCHMARKS:
+            old = [r["events_per_s"] for r in baseline if r["benchmark"] == name]
+            new = [r["events_per_s"] for r in results if r["benchmark"] == name]
+            if old and new:
+                ratio = (sum(new) / len(new)) / (sum(old) / len(old))
+                print("%-16s %6.3fx events/s vs baseline" % (name, ratio), file=sys.stderr)
+
+    return 0 if results else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
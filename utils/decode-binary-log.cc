@@ -0,0 +1,66 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup logbinary
+ * Print the messages of a binary log file, as they would have been
+ * logged on \c std::clog.
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/log-binary.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Print the messages of a binary log file written with "
+              "NS_LOG=...:binary-log=<file>.");
+    cmd.AddNonOption("input", "The binary log file", input);
+    cmd.AddValue("output", "The file to write the messages to, instead of the standard output", output);
+    cmd.Parse(argc, argv);
+
+    std::ifstream is(input, std::ios::binary);
+    if (!is.is_open())
+    {
+        std::cerr << "Can't open \"" << input << "\"" << std::endl;
+        return 1;
+    }
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+        if (!file.is_open())
+        {
+            std::cerr << "Can't open \"" << output << "\"" << std::endl;
+            return 1;
+        }
+    }
+    if (!LogBinaryDecode(is, output.empty() ? std::cout : file))
+    {
+        std::cerr << "\"" << input << "\" is not a binary log file, or is truncated" << std::endl;
+        return 1;
+    }
+    return 0;
+}